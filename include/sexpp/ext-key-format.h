@@ -89,6 +89,10 @@ class SEXP_PUBLIC_SYMBOL ext_key_input_stream_t : public sexp::sexp_input_stream
         : sexp_input_stream_t(i, md), is_scanning_value(false), has_key(false)
     {
     }
+    ext_key_input_stream_t(sexp::sexp_byte_source_t *s, size_t md = 0)
+        : sexp_input_stream_t(s, md), is_scanning_value(false), has_key(false)
+    {
+    }
     virtual ~ext_key_input_stream_t() = default;
     void scan(extended_private_key_t &extended_key);
 };
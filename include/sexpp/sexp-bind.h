@@ -0,0 +1,463 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP binding to C++ structs
+ * A struct is bound by specializing sexp_bind_t for it with a schema: a static member
+ * function template that declares the fields by name and member pointer.
+ *
+ *   struct rsa_key_t {
+ *       sexp_simple_string_t     n, e;
+ *       uint32_t                 bits = 0;
+ *       std::vector<std::string> comments;
+ *   };
+ *
+ *   template <> struct sexp_bind_t<rsa_key_t> {
+ *       template <typename B> static void schema(B &b)
+ *       {
+ *           b.field("n", &rsa_key_t::n);
+ *           b.field("e", &rsa_key_t::e);
+ *           b.optional("bits", &rsa_key_t::bits);
+ *           b.repeated("comment", &rsa_key_t::comments);
+ *       }
+ *   };
+ *
+ * A bound struct is a list of fields, and each field is a list that starts with the
+ * field name: (rsa (n #00c1...#) (e #010001#) (comment "a") (comment "b")).  Field
+ * values are
+ *   - bytes: sexp_simple_string_t or std::string, an atom without presentation hint;
+ *   - unsigned: uint32_t, a decimal atom;
+ *   - nested structs with their own sexp_bind_t, whose fields follow the name:
+ *     (private-key (rsa (n ...) (e ...))).
+ * field() must appear exactly once, optional() at most once and keeps the value of
+ * the struct if it is absent, repeated() appends every occurrence to a std::vector.
+ * Fields may come in any order; elements that are not declared are skipped.
+ * A schema declares at most 64 fields.
+ *
+ * Bound structs are filled directly from the input stream and printed directly in
+ * canonical form, no tree is built.  Optional fields are always printed.  Malformed
+ * input and violations of the schema are reported with sexp_error.
+ */
+
+template <typename T> struct sexp_bind_t;
+
+/*
+ * Non-template part of the binding
+ */
+class SEXP_PUBLIC_SYMBOL sexp_bind_input_t {
+  public:
+    static const size_t MAX_FIELDS = 64;
+
+    /* Reads '(' and the name of a field */
+    static sexp_simple_string_t open_field(sexp_input_stream_t *sis);
+    /* Reads the ')' closing a field */
+    static void close_field(sexp_input_stream_t *sis);
+    /* Skips the rest of a field including the closing ')' */
+    static void skip_field(sexp_input_stream_t *sis);
+    /* Skips a list or a string with its presentation hint */
+    static void skip_object(sexp_input_stream_t *sis);
+
+    static sexp_simple_string_t scan_bytes(sexp_input_stream_t *sis);
+    static uint32_t             scan_unsigned(sexp_input_stream_t *sis);
+
+    static bool is_name(const sexp_simple_string_t &name, const char *expected, size_t length)
+    {
+        return name.length() == length && std::memcmp(name.data(), expected, length) == 0;
+    }
+    static void unexpected_field(sexp_input_stream_t *       sis,
+                                 const sexp_simple_string_t &name,
+                                 const char *                expected);
+    static void duplicate_field(sexp_input_stream_t *sis, const char *name);
+    static void missing_field(sexp_input_stream_t *sis, const char *name);
+    static void too_many_fields(sexp_input_stream_t *sis);
+};
+
+/*
+ * Canonical output of bound structs goes to a sink, which provides
+ *   void open(void);                      puts '('
+ *   void close(void);                     puts ')'
+ *   void put(const octet_t *bt, size_t ln);
+ */
+
+/* Writes to an output stream, which checks list nesting */
+class sexp_bind_stream_sink_t {
+    sexp_output_stream_t *os;
+
+  public:
+    explicit sexp_bind_stream_sink_t(sexp_output_stream_t *o) : os(o) {}
+    void open(void) { os->var_open_list(); }
+    void close(void) { os->var_close_list(); }
+    void put(const octet_t *bt, size_t ln) { os->var_put_chars(bt, ln); }
+};
+
+/* Writes to a caller buffer of sufficient size, see sexp_bind_canonical_length() */
+class sexp_bind_buffer_sink_t {
+    octet_t *pos;
+
+  public:
+    explicit sexp_bind_buffer_sink_t(octet_t *buf) : pos(buf) {}
+    void     open(void) { *pos++ = '('; }
+    void     close(void) { *pos++ = ')'; }
+    void     put(const octet_t *bt, size_t ln)
+    {
+        std::memcpy(pos, bt, ln);
+        pos += ln;
+    }
+    octet_t *end(void) const noexcept { return pos; }
+};
+
+/* Counts the bytes that would be written */
+class sexp_bind_length_sink_t {
+    size_t length;
+
+  public:
+    sexp_bind_length_sink_t(void) : length(0) {}
+    void   open(void) { length++; }
+    void   close(void) { length++; }
+    void   put(const octet_t *, size_t ln) { length += ln; }
+    size_t get_length(void) const noexcept { return length; }
+};
+
+/*
+ * Length prefix "L:" of a verbatim atom of length L, computed at compile time.  Field
+ * names are string literals, so the framing of a field up to its value is written
+ * from constants: '(', the prefix and the name.
+ */
+template <size_t L, char... D>
+struct sexp_bind_prefix_t : sexp_bind_prefix_t<L / 10, char('0' + L % 10), D...> {
+};
+
+template <char... D> struct sexp_bind_prefix_t<0, D...> {
+    static constexpr size_t  size = sizeof...(D) + 1;
+    static constexpr octet_t chars[sizeof...(D) + 1] = {octet_t(D)..., octet_t(':')};
+};
+
+template <char... D> constexpr size_t  sexp_bind_prefix_t<0, D...>::size;
+template <char... D> constexpr octet_t sexp_bind_prefix_t<0, D...>::chars[];
+
+/*
+ * sexp_bind_put_token(sink, name)
+ * Puts a field name as a verbatim atom
+ */
+template <typename Sink, size_t N> void sexp_bind_put_token(Sink &sink, const char (&name)[N])
+{
+    static_assert(N > 1, "field names shall not be empty");
+    typedef sexp_bind_prefix_t<N - 1> prefix;
+    sink.put(prefix::chars, prefix::size);
+    sink.put(reinterpret_cast<const octet_t *>(name), N - 1);
+}
+
+/*
+ * sexp_bind_put_atom(sink, bt, ln)
+ * Puts a verbatim atom whose length is known at run time only
+ */
+template <typename Sink> void sexp_bind_put_atom(Sink &sink, const octet_t *bt, size_t ln)
+{
+    octet_t  buf[24];
+    octet_t *pos = buf + sizeof(buf);
+    *--pos = ':';
+    size_t   n = ln;
+    do {
+        *--pos = octet_t('0' + n % 10);
+        n /= 10;
+    } while (n != 0);
+    sink.put(pos, buf + sizeof(buf) - pos);
+    sink.put(bt, ln);
+}
+
+template <typename T> void sexp_bind_scan_fields(sexp_input_stream_t *sis, T &value);
+template <typename Sink, typename T> void sexp_bind_print_fields(Sink &sink, const T &value);
+
+/*
+ * Scanning and printing of a field value, which follows the field name.  Nested
+ * structs are the default.
+ */
+template <typename V> struct sexp_bind_value_t {
+    static void scan(sexp_input_stream_t *sis, V &value) { sexp_bind_scan_fields(sis, value); }
+    template <typename Sink> static void print(Sink &sink, const V &value)
+    {
+        sexp_bind_print_fields(sink, value);
+    }
+};
+
+template <> struct sexp_bind_value_t<sexp_simple_string_t> {
+    static void scan(sexp_input_stream_t *sis, sexp_simple_string_t &value)
+    {
+        value = sexp_bind_input_t::scan_bytes(sis);
+        sexp_bind_input_t::close_field(sis);
+    }
+    template <typename Sink> static void print(Sink &sink, const sexp_simple_string_t &value)
+    {
+        sexp_bind_put_atom(sink, value.data(), value.length());
+    }
+};
+
+template <> struct sexp_bind_value_t<std::string> {
+    static void scan(sexp_input_stream_t *sis, std::string &value)
+    {
+        sexp_simple_string_t ss = sexp_bind_input_t::scan_bytes(sis);
+        value.assign(reinterpret_cast<const char *>(ss.data()), ss.length());
+        sexp_bind_input_t::close_field(sis);
+    }
+    template <typename Sink> static void print(Sink &sink, const std::string &value)
+    {
+        sexp_bind_put_atom(
+          sink, reinterpret_cast<const octet_t *>(value.data()), value.length());
+    }
+};
+
+template <> struct sexp_bind_value_t<uint32_t> {
+    static void scan(sexp_input_stream_t *sis, uint32_t &value)
+    {
+        value = sexp_bind_input_t::scan_unsigned(sis);
+        sexp_bind_input_t::close_field(sis);
+    }
+    template <typename Sink> static void print(Sink &sink, uint32_t value)
+    {
+        octet_t  buf[10];
+        octet_t *pos = buf + sizeof(buf);
+        do {
+            *--pos = octet_t('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        sexp_bind_put_atom(sink, pos, buf + sizeof(buf) - pos);
+    }
+};
+
+/*
+ * sexp_bind_scanner_t
+ * Schema visitor that scans one field of T: the field whose name was read is looked up
+ * among the declared fields, in declaration order.  The same visitor checks at the end
+ * of the struct that all required fields were found.
+ */
+template <typename T> class sexp_bind_scanner_t {
+  private:
+    sexp_input_stream_t *sis;
+    T &                  value;
+    sexp_simple_string_t name;     /* name of the current field */
+    uint64_t             found;    /* fields found so far, by declaration index */
+    size_t               index;    /* declaration index during a schema walk */
+    bool                 matched;  /* the current field was scanned */
+    bool                 checking; /* the walk checks required fields */
+
+    /* Returns true if the declaration at the current index shall be scanned */
+    bool select(const char *field_name, size_t length, bool once)
+    {
+        size_t i = index++;
+        if (i >= sexp_bind_input_t::MAX_FIELDS)
+            sexp_bind_input_t::too_many_fields(sis);
+        if (checking || matched || !sexp_bind_input_t::is_name(name, field_name, length))
+            return false;
+        if (once && (found & (uint64_t(1) << i)) != 0)
+            sexp_bind_input_t::duplicate_field(sis, field_name);
+        found |= uint64_t(1) << i;
+        matched = true;
+        return true;
+    }
+
+  public:
+    sexp_bind_scanner_t(sexp_input_stream_t *s, T &v)
+        : sis(s), value(v), found(0), index(0), matched(false), checking(false)
+    {
+    }
+
+    template <size_t N, typename V> void field(const char (&field_name)[N], V T::*member)
+    {
+        if (select(field_name, N - 1, true))
+            sexp_bind_value_t<V>::scan(sis, value.*member);
+        else if (checking && (found & (uint64_t(1) << (index - 1))) == 0)
+            sexp_bind_input_t::missing_field(sis, field_name);
+    }
+    template <size_t N, typename V> void optional(const char (&field_name)[N], V T::*member)
+    {
+        if (select(field_name, N - 1, true))
+            sexp_bind_value_t<V>::scan(sis, value.*member);
+    }
+    template <size_t N, typename V>
+    void repeated(const char (&field_name)[N], std::vector<V> T::*member)
+    {
+        if (select(field_name, N - 1, false)) {
+            (value.*member).emplace_back();
+            sexp_bind_value_t<V>::scan(sis, (value.*member).back());
+        }
+    }
+
+    /* Scans the field that starts at the current character */
+    void scan_field(void)
+    {
+        if (sis->get_next_char() != '(') {
+            sexp_bind_input_t::skip_object(sis);
+            return;
+        }
+        name = sexp_bind_input_t::open_field(sis);
+        index = 0;
+        matched = false;
+        sexp_bind_t<T>::schema(*this);
+        if (!matched)
+            sexp_bind_input_t::skip_field(sis);
+    }
+    /* Reports the first required field that was not found */
+    void check(void)
+    {
+        index = 0;
+        checking = true;
+        sexp_bind_t<T>::schema(*this);
+    }
+};
+
+/*
+ * sexp_bind_scan_fields(sis, value)
+ * Scans the fields of a struct up to and including the ')' that closes it
+ */
+template <typename T> void sexp_bind_scan_fields(sexp_input_stream_t *sis, T &value)
+{
+    sexp_bind_scanner_t<T> scanner(sis, value);
+    sis->skip_white_space();
+    while (sis->get_next_char() != ')') {
+        scanner.scan_field();
+        sis->skip_white_space();
+    }
+    sis->close_list();
+    scanner.check();
+}
+
+/*
+ * sexp_bind_printer_t
+ * Schema visitor that prints all fields of T in declaration order
+ */
+template <typename T, typename Sink> class sexp_bind_printer_t {
+  private:
+    Sink &   sink;
+    const T &value;
+
+  public:
+    sexp_bind_printer_t(Sink &s, const T &v) : sink(s), value(v) {}
+
+    /* Prints field name with value v */
+    template <size_t N, typename V>
+    static void print(Sink &out, const char (&name)[N], const V &v)
+    {
+        out.open();
+        sexp_bind_put_token(out, name);
+        sexp_bind_value_t<V>::print(out, v);
+        out.close();
+    }
+
+    template <size_t N, typename V> void field(const char (&field_name)[N], V T::*member)
+    {
+        print(sink, field_name, value.*member);
+    }
+    template <size_t N, typename V> void optional(const char (&field_name)[N], V T::*member)
+    {
+        print(sink, field_name, value.*member);
+    }
+    template <size_t N, typename V>
+    void repeated(const char (&field_name)[N], std::vector<V> T::*member)
+    {
+        for (const auto &v : value.*member)
+            print(sink, field_name, v);
+    }
+};
+
+/*
+ * sexp_bind_print_fields(sink, value)
+ * Prints the fields of a struct, without the enclosing list
+ */
+template <typename Sink, typename T> void sexp_bind_print_fields(Sink &sink, const T &value)
+{
+    sexp_bind_printer_t<T, Sink> printer(sink, value);
+    sexp_bind_t<T>::schema(printer);
+}
+
+/*
+ * sexp_bind_print(os, name, value)
+ * Prints (name ...) in canonical form, the image sexp_bind_scan() reads into value
+ */
+template <size_t N, typename T>
+sexp_output_stream_t *sexp_bind_print(sexp_output_stream_t *os,
+                                      const char (&name)[N],
+                                      const T &value)
+{
+    sexp_bind_stream_sink_t sink(os);
+    sexp_bind_printer_t<T, sexp_bind_stream_sink_t>::print(sink, name, value);
+    return os;
+}
+
+/*
+ * sexp_bind_print(buf, name, value)
+ * Writes the canonical image of (name ...) to buf, which shall hold at least
+ * sexp_bind_canonical_length(name, value) bytes.  Returns the end of the image.
+ */
+template <size_t N, typename T>
+octet_t *sexp_bind_print(octet_t *buf, const char (&name)[N], const T &value)
+{
+    sexp_bind_buffer_sink_t sink(buf);
+    sexp_bind_printer_t<T, sexp_bind_buffer_sink_t>::print(sink, name, value);
+    return sink.end();
+}
+
+/*
+ * sexp_bind_canonical_length(name, value)
+ * Returns the length of the canonical image of (name ...)
+ */
+template <size_t N, typename T>
+size_t sexp_bind_canonical_length(const char (&name)[N], const T &value)
+{
+    sexp_bind_length_sink_t sink;
+    sexp_bind_printer_t<T, sexp_bind_length_sink_t>::print(sink, name, value);
+    return sink.get_length();
+}
+
+/*
+ * sexp_bind_scan(sis, name, value)
+ * Scans (name ...) into value, which is a bound struct or any other field value type.
+ * Like scan_object() it expects the first character to be read already.
+ */
+template <size_t N, typename T>
+void sexp_bind_scan(sexp_input_stream_t *sis, const char (&name)[N], T &value)
+{
+    sis->skip_white_space();
+    if (sis->get_next_char() == '{' && sis->get_byte_size() != 6) {
+        sis->set_byte_size(6)->skip_char('{');
+        sexp_bind_scan(sis, name, value);
+        sis->skip_char('}');
+        return;
+    }
+    sexp_simple_string_t field_name = sexp_bind_input_t::open_field(sis);
+    if (!sexp_bind_input_t::is_name(field_name, name, N - 1))
+        sexp_bind_input_t::unexpected_field(sis, field_name, name);
+    sexp_bind_value_t<T>::scan(sis, value);
+}
+
+} // namespace sexp
@@ -0,0 +1,86 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP digest sink
+ * Output sink that hashes bytes as they are written, so digests of canonical images
+ * are computed without materializing them.  SHA-1 and SHA-256 are built in.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_digest_sink_t : public sexp_byte_sink_t {
+  public:
+    enum algorithm_t { sha1 = 1, sha256 = 2 };
+
+  private:
+    algorithm_t algorithm;
+    uint32_t    state[8];  /* chaining value */
+    uint64_t    length;    /* number of bytes hashed */
+    octet_t     block[64]; /* partial block */
+    size_t      used;      /* number of bytes in block */
+
+    void compress(const octet_t *bt);
+
+  public:
+    sexp_digest_sink_t(algorithm_t alg = sha256) : algorithm(alg) { reset(); }
+
+    virtual void put(octet_t c)
+    {
+        block[used++] = c;
+        length++;
+        if (used == sizeof(block)) {
+            compress(block);
+            used = 0;
+        }
+    }
+    virtual void write(const octet_t *bt, size_t ln);
+
+    algorithm_t get_algorithm(void) const noexcept { return algorithm; }
+    size_t      digest_size(void) const noexcept { return algorithm == sha1 ? 20 : 32; }
+    /* Starts a new digest */
+    void reset(void);
+    /* Returns the digest of bytes written since reset and starts a new one */
+    octet_string finish(void);
+};
+
+/*
+ * canonical_digest(obj, alg)
+ * Returns the digest of the canonical image of obj.
+ */
+SEXP_PUBLIC_SYMBOL octet_string canonical_digest(
+  const sexp_object_t &obj, sexp_digest_sink_t::algorithm_t alg = sexp_digest_sink_t::sha256);
+
+inline octet_string canonical_digest(
+  const std::shared_ptr<sexp_object_t> &obj,
+  sexp_digest_sink_t::algorithm_t       alg = sexp_digest_sink_t::sha256)
+{
+    return canonical_digest(*obj, alg);
+}
+
+} // namespace sexp
@@ -0,0 +1,159 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP format builder
+ * Builds canonical S-expressions from a format in advanced syntax with directives in
+ * place of atoms, in the manner of gcry_sexp_build:
+ *
+ *   sexp_build(os, "(public-key (rsa (n %b) (e %b)))", {{n, n_len}, {e, e_len}});
+ *
+ * Directives take arguments in order:
+ *   %s  bytes, usually a C string
+ *   %b  bytes given as pointer and length
+ *   %u  unsigned number, printed as a decimal atom
+ *   %d  signed number, printed as a decimal atom
+ *   %S  S-expression object, printed in canonical form
+ * A format is compiled once into runs of constant canonical bytes separated by
+ * directives, so building writes each constant run with one call and formats only
+ * the arguments.  sexp_build() caches compiled formats by the address of the format,
+ * so formats should be strings with static storage, e.g. literals; the text is
+ * checked on every use, and a buffer reused for another format is compiled again.
+ * Malformed formats and arguments that do not match directives are reported with
+ * sexp_error.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_format_arg_t {
+  public:
+    enum kind_t { bytes_kind, unsigned_kind, signed_kind, object_kind };
+
+  private:
+    kind_t kind;
+    union {
+        struct {
+            const octet_t *data;
+            size_t         length;
+        } bytes;
+        uint64_t             unsigned_value;
+        int64_t              signed_value;
+        const sexp_object_t *object;
+    } value;
+
+  public:
+    sexp_format_arg_t(const char *str) : kind(bytes_kind)
+    {
+        value.bytes.data = reinterpret_cast<const octet_t *>(str);
+        value.bytes.length = std::strlen(str);
+    }
+    sexp_format_arg_t(const octet_t *bt, size_t ln) : kind(bytes_kind)
+    {
+        value.bytes.data = bt;
+        value.bytes.length = ln;
+    }
+    sexp_format_arg_t(const void *bt, size_t ln)
+        : sexp_format_arg_t(static_cast<const octet_t *>(bt), ln)
+    {
+    }
+    sexp_format_arg_t(const std::string &str)
+        : sexp_format_arg_t(reinterpret_cast<const octet_t *>(str.data()), str.length())
+    {
+    }
+    sexp_format_arg_t(const sexp_simple_string_t &ss)
+        : sexp_format_arg_t(ss.data(), ss.length())
+    {
+    }
+    sexp_format_arg_t(unsigned v) : kind(unsigned_kind) { value.unsigned_value = v; }
+    sexp_format_arg_t(unsigned long v) : kind(unsigned_kind) { value.unsigned_value = v; }
+    sexp_format_arg_t(unsigned long long v) : kind(unsigned_kind) { value.unsigned_value = v; }
+    sexp_format_arg_t(int v) : kind(signed_kind) { value.signed_value = v; }
+    sexp_format_arg_t(long v) : kind(signed_kind) { value.signed_value = v; }
+    sexp_format_arg_t(long long v) : kind(signed_kind) { value.signed_value = v; }
+    sexp_format_arg_t(const sexp_object_t &obj) : kind(object_kind) { value.object = &obj; }
+
+    kind_t               get_kind(void) const noexcept { return kind; }
+    const octet_t *      get_data(void) const noexcept { return value.bytes.data; }
+    size_t               get_length(void) const noexcept { return value.bytes.length; }
+    uint64_t             get_unsigned(void) const noexcept { return value.unsigned_value; }
+    int64_t              get_signed(void) const noexcept { return value.signed_value; }
+    const sexp_object_t *get_object(void) const noexcept { return value.object; }
+};
+
+class SEXP_PUBLIC_SYMBOL sexp_format_t {
+  private:
+    /* Constant bytes followed by a directive, or by nothing at the end of the format */
+    struct step_t {
+        size_t offset;
+        size_t length;
+        char   directive;
+    };
+
+    std::string         constants;
+    std::vector<step_t> steps;
+    size_t              directives;
+
+    void put_arg(sexp_output_stream_t *os, char directive, const sexp_format_arg_t &arg) const;
+
+  public:
+    explicit sexp_format_t(const char *format);
+
+    /* Number of arguments the format takes */
+    size_t arg_count(void) const noexcept { return directives; }
+
+    sexp_output_stream_t *print(sexp_output_stream_t *                  os,
+                                std::initializer_list<sexp_format_arg_t> args) const
+    {
+        return print(os, args.begin(), args.size());
+    }
+    sexp_output_stream_t *print(sexp_output_stream_t *   os,
+                                const sexp_format_arg_t *args,
+                                size_t                   count) const;
+
+    /* Returns the compiled format, compiling it on first use */
+    static std::shared_ptr<const sexp_format_t> compiled(const char *format);
+};
+
+/*
+ * sexp_build(os, format, args)
+ * Prints the canonical image of format with args, see sexp_format_t
+ */
+inline sexp_output_stream_t *sexp_build(sexp_output_stream_t *                  os,
+                                        const char *                            format,
+                                        std::initializer_list<sexp_format_arg_t> args)
+{
+    return sexp_format_t::compiled(format)->print(os, args);
+}
+
+} // namespace sexp
@@ -0,0 +1,98 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP hash-consing table
+ * Keeps one node for every distinct string and list.  An input stream with a
+ * hash-consing table returns the node from the table for every object it scans, so
+ * identical subtrees of all trees scanned with the same table are one shared node and
+ * equality of such subtrees is decided by comparing pointers.
+ *
+ * Lists are shared bottom up: a list is looked up after its elements, which are
+ * already shared, so looking up a list compares its elements by pointer.
+ *
+ * Nodes added to the table and their elements are marked shared, see
+ * sexp_object_t::set_shared(), so modifying them raises an error.  By default the table
+ * keeps every atom, including key material, until it is cleared or purged; with
+ * token_atoms it keeps only atoms that the intern table would keep and lists built of
+ * them, other objects are returned as they are.  Nodes are kept as they were allocated
+ * by the stream; with SEXP_WITH_PMR the memory resource of the stream must outlive the
+ * table and the trees.  The table is safe for concurrent use.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_hashcons_table_t {
+  public:
+    static const size_t SHARDS = 16;
+
+    /* Atoms kept by the table */
+    enum atoms_t {
+        all_atoms,  /* every atom */
+        token_atoms /* atoms without presentation hint whose data is a token */
+    };
+
+  private:
+    struct shard_t {
+        std::mutex lock;
+        std::unordered_set<std::shared_ptr<sexp_object_t>, sexp_object_hash_t, sexp_object_equal_t>
+          nodes;
+    };
+
+    shard_t shards[SHARDS];
+    atoms_t atoms;
+
+  public:
+    sexp_hashcons_table_t(atoms_t a = all_atoms) : atoms(a) {}
+
+    /* Checks whether obj qualifies for sharing */
+    bool can_share(const sexp_object_t &obj) const;
+    /* Returns the node equal to obj, adds obj as the node if there is none; returns obj
+     * if it does not qualify */
+    std::shared_ptr<sexp_object_t> share(const std::shared_ptr<sexp_object_t> &obj);
+    std::shared_ptr<sexp_string_t> share(const std::shared_ptr<sexp_string_t> &str)
+    {
+        return std::static_pointer_cast<sexp_string_t>(
+          share(std::static_pointer_cast<sexp_object_t>(str)));
+    }
+    std::shared_ptr<sexp_list_t> share(const std::shared_ptr<sexp_list_t> &list)
+    {
+        return std::static_pointer_cast<sexp_list_t>(
+          share(std::static_pointer_cast<sexp_object_t>(list)));
+    }
+
+    size_t size(void);
+    /* Forgets nodes that are referenced by the table only, returns their number */
+    size_t purge(void);
+    void   clear(void);
+};
+
+} // namespace sexp
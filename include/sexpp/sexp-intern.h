@@ -0,0 +1,81 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP intern table
+ * Shares one string node among all occurrences of the same short atom, e.g. the
+ * tokens and presentation hints that repeat in every key.  An input stream with an
+ * intern table returns the shared node for such atoms, so atoms scanned with the
+ * same table may be compared by pointer.
+ *
+ * Only atoms whose data and hint are tokens no longer than max_length are interned,
+ * so key material is not retained by the table.  Interned nodes are shared between
+ * trees and are marked shared, see sexp_object_t::set_shared(), so modifying them raises
+ * an error; they are allocated from the default heap, not from the memory resource of
+ * the stream.  The table is safe for concurrent use; it is
+ * split into shards with separate locks to keep contention low.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_intern_table_t {
+  public:
+    static const size_t DEFAULT_MAX_LENGTH = 32;
+    static const size_t SHARDS = 16;
+
+  private:
+    struct shard_t {
+        std::mutex                                                      lock;
+        std::unordered_map<std::string, std::shared_ptr<sexp_string_t>> nodes;
+    };
+
+    shard_t shards[SHARDS];
+    size_t  max_length;
+
+    static std::string key(const sexp_string_t &str);
+    std::shared_ptr<sexp_string_t> lookup(const std::string &k, sexp_string_t &&str);
+
+  public:
+    sexp_intern_table_t(size_t m_length = DEFAULT_MAX_LENGTH) : max_length(m_length) {}
+
+    /* Checks whether str qualifies for interning */
+    bool can_intern(const sexp_string_t &str) const;
+    /* Returns the shared node equal to str, or a new unshared node if str does not
+     * qualify */
+    std::shared_ptr<sexp_string_t> intern(sexp_string_t &&str);
+    /* Returns the shared node for a token without presentation hint */
+    std::shared_ptr<sexp_string_t> intern(const std::string &token);
+
+    size_t size(void);
+    void   clear(void);
+};
+
+} // namespace sexp
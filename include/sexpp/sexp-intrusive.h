@@ -0,0 +1,359 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <typeinfo>
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * Reference count policies
+ * The atomic count lets pointers to a node be copied and dropped by many threads;
+ * the local one is cheaper but the whole tree shall be used by one thread at a time.
+ */
+
+class sexp_atomic_refcount_t {
+    std::atomic<uint32_t> count;
+
+  public:
+    sexp_atomic_refcount_t(void) noexcept : count(0) {}
+    void     acquire(void) noexcept { count.fetch_add(1, std::memory_order_relaxed); }
+    bool     release(void) noexcept
+    {
+        return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+    uint32_t get(void) const noexcept { return count.load(std::memory_order_relaxed); }
+};
+
+class sexp_local_refcount_t {
+    uint32_t count;
+
+  public:
+    sexp_local_refcount_t(void) noexcept : count(0) {}
+    void     acquire(void) noexcept { count++; }
+    bool     release(void) noexcept { return --count == 0; }
+    uint32_t get(void) const noexcept { return count; }
+};
+
+/*
+ * Intrusive pointer
+ * Points to an object that keeps its own reference count: T::add_ref() takes a
+ * reference, T::release_ref() drops one and destroys the object with the last one.  The
+ * pointer is one machine word and needs no separate control block.
+ */
+
+template <typename T> class sexp_intrusive_ptr_t {
+    template <typename U> friend class sexp_intrusive_ptr_t;
+
+    T *ptr;
+
+  public:
+    typedef T element_type;
+
+    sexp_intrusive_ptr_t(void) noexcept : ptr(nullptr) {}
+    sexp_intrusive_ptr_t(std::nullptr_t) noexcept : ptr(nullptr) {}
+    /* Takes a new reference to p */
+    explicit sexp_intrusive_ptr_t(T *p) noexcept : ptr(p)
+    {
+        if (ptr != nullptr)
+            ptr->add_ref();
+    }
+    sexp_intrusive_ptr_t(const sexp_intrusive_ptr_t &other) noexcept
+        : sexp_intrusive_ptr_t(other.ptr)
+    {
+    }
+    sexp_intrusive_ptr_t(sexp_intrusive_ptr_t &&other) noexcept : ptr(other.ptr)
+    {
+        other.ptr = nullptr;
+    }
+    template <typename U,
+              typename = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+    sexp_intrusive_ptr_t(const sexp_intrusive_ptr_t<U> &other) noexcept
+        : sexp_intrusive_ptr_t(static_cast<T *>(other.ptr))
+    {
+    }
+    template <typename U,
+              typename = typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+    sexp_intrusive_ptr_t(sexp_intrusive_ptr_t<U> &&other) noexcept : ptr(other.ptr)
+    {
+        other.ptr = nullptr;
+    }
+    ~sexp_intrusive_ptr_t()
+    {
+        if (ptr != nullptr)
+            ptr->release_ref();
+    }
+
+    sexp_intrusive_ptr_t &operator=(sexp_intrusive_ptr_t other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+    void swap(sexp_intrusive_ptr_t &other) noexcept { std::swap(ptr, other.ptr); }
+    void reset(void) noexcept { sexp_intrusive_ptr_t().swap(*this); }
+
+    T *      get(void) const noexcept { return ptr; }
+    T &      operator*(void) const noexcept { return *ptr; }
+    T *      operator->(void) const noexcept { return ptr; }
+    explicit operator bool(void) const noexcept { return ptr != nullptr; }
+    uint32_t use_count(void) const noexcept { return ptr != nullptr ? ptr->use_count() : 0; }
+};
+
+template <typename T, typename U>
+inline bool operator==(const sexp_intrusive_ptr_t<T> &left,
+                       const sexp_intrusive_ptr_t<U> &right)
+{
+    return left.get() == right.get();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const sexp_intrusive_ptr_t<T> &left,
+                       const sexp_intrusive_ptr_t<U> &right)
+{
+    return left.get() != right.get();
+}
+
+template <typename T>
+inline bool operator==(const sexp_intrusive_ptr_t<T> &left, std::nullptr_t)
+{
+    return left.get() == nullptr;
+}
+
+template <typename T>
+inline bool operator!=(const sexp_intrusive_ptr_t<T> &left, std::nullptr_t)
+{
+    return left.get() != nullptr;
+}
+
+/*
+ * Reference counted SEXP nodes
+ * A compact variant of the object model for trees that are scanned, read and then
+ * dropped: nodes carry their reference count, lists hold intrusive pointers, and
+ * nodes have no virtual functions.  Count is one of the policies above.
+ *
+ * scan() reads an object like sexp_input_stream_t::scan_object() does, without the
+ * intern and hash-consing tables of the stream; to_object() and from_object()
+ * convert from and to the shared_ptr based model.  from_object() reports objects that
+ * are not plain strings and lists, e.g. of derived classes, with sexp_error.
+ */
+
+template <typename Count> class sexp_ref_list_t;
+template <typename Count> class sexp_ref_string_t;
+
+template <typename Count> class sexp_ref_object_t {
+  public:
+    typedef sexp_intrusive_ptr_t<sexp_ref_object_t> ptr_t;
+
+  private:
+    mutable Count refs;
+    const bool    list;
+
+  protected:
+    explicit sexp_ref_object_t(bool is_list) noexcept : list(is_list) {}
+    ~sexp_ref_object_t() = default;
+
+  public:
+    sexp_ref_object_t(const sexp_ref_object_t &) = delete;
+    sexp_ref_object_t &operator=(const sexp_ref_object_t &) = delete;
+
+    void     add_ref(void) const noexcept { refs.acquire(); }
+    void     release_ref(void) const noexcept;
+    uint32_t use_count(void) const noexcept { return refs.get(); }
+
+    bool is_sexp_list(void) const noexcept { return list; }
+    bool is_sexp_string(void) const noexcept { return !list; }
+    /* Return the node as list or string, nullptr if it is not one */
+    const sexp_ref_list_t<Count> *list_view(void) const noexcept
+    {
+        return list ? static_cast<const sexp_ref_list_t<Count> *>(this) : nullptr;
+    }
+    const sexp_ref_string_t<Count> *string_view(void) const noexcept
+    {
+        return list ? nullptr : static_cast<const sexp_ref_string_t<Count> *>(this);
+    }
+
+    sexp_output_stream_t *         print_canonical(sexp_output_stream_t *os) const;
+    std::shared_ptr<sexp_object_t> to_object(void) const;
+
+    static ptr_t scan(sexp_input_stream_t *sis);
+    static ptr_t from_object(const sexp_object_t &obj);
+};
+
+template <typename Count> class sexp_ref_string_t : public sexp_ref_object_t<Count> {
+  private:
+    sexp_presentation_hint_t presentation_hint;
+    sexp_simple_string_t     data_string;
+
+  public:
+    explicit sexp_ref_string_t(sexp_simple_string_t &&ss)
+        : sexp_ref_object_t<Count>(false), data_string(std::move(ss))
+    {
+    }
+    sexp_ref_string_t(sexp_simple_string_t &&ph, sexp_simple_string_t &&ss)
+        : sexp_ref_object_t<Count>(false), presentation_hint(std::move(ph)),
+          data_string(std::move(ss))
+    {
+    }
+
+    bool has_presentation_hint(void) const noexcept { return presentation_hint.has_value(); }
+    const sexp_simple_string_t &get_string(void) const noexcept { return data_string; }
+    const sexp_simple_string_t &get_presentation_hint(void) const noexcept
+    {
+        return presentation_hint.get();
+    }
+};
+
+template <typename Count>
+class sexp_ref_list_t
+    : public sexp_ref_object_t<Count>,
+      public sexp_small_vector_t<typename sexp_ref_object_t<Count>::ptr_t, 4> {
+  public:
+    sexp_ref_list_t(void) : sexp_ref_object_t<Count>(true) {}
+};
+
+/*
+ * sexp_ref_object_t::release_ref()
+ * Nodes are destroyed as their own type, so no virtual destructor is needed.
+ */
+template <typename Count> void sexp_ref_object_t<Count>::release_ref(void) const noexcept
+{
+    if (!refs.release())
+        return;
+    if (list)
+        delete static_cast<const sexp_ref_list_t<Count> *>(this);
+    else
+        delete static_cast<const sexp_ref_string_t<Count> *>(this);
+}
+
+/*
+ * sexp_ref_object_t::print_canonical(os)
+ */
+template <typename Count>
+sexp_output_stream_t *sexp_ref_object_t<Count>::print_canonical(sexp_output_stream_t *os) const
+{
+    if (list) {
+        os->var_open_list();
+        for (const auto &child : *list_view())
+            child->print_canonical(os);
+        return os->var_close_list();
+    }
+    const sexp_ref_string_t<Count> *str = string_view();
+    if (str->has_presentation_hint()) {
+        os->var_put_char('[');
+        str->get_presentation_hint().print_canonical_verbatim(os);
+        os->var_put_char(']');
+    }
+    return str->get_string().print_canonical_verbatim(os);
+}
+
+/*
+ * sexp_ref_object_t::to_object()
+ */
+template <typename Count>
+std::shared_ptr<sexp_object_t> sexp_ref_object_t<Count>::to_object(void) const
+{
+    if (list) {
+        auto res = std::make_shared<sexp_list_t>();
+        for (const auto &child : *list_view())
+            res->push_back(child->to_object());
+        return res;
+    }
+    const sexp_ref_string_t<Count> *str = string_view();
+    auto                            res = std::make_shared<sexp_string_t>();
+    if (str->has_presentation_hint())
+        res->set_presentation_hint(str->get_presentation_hint());
+    res->set_string(str->get_string());
+    return res;
+}
+
+/*
+ * sexp_ref_object_t::from_object(obj)
+ * Only strings and lists themselves are converted: other objects have nothing to
+ * convert to, and objects of derived classes would lose their overrides.
+ */
+template <typename Count>
+typename sexp_ref_object_t<Count>::ptr_t sexp_ref_object_t<Count>::from_object(
+  const sexp_object_t &obj)
+{
+    if (obj.get_kind() == sexp_object_t::list_kind && typeid(obj) == typeid(sexp_list_t)) {
+        sexp_intrusive_ptr_t<sexp_ref_list_t<Count>> res(new sexp_ref_list_t<Count>());
+        for (const auto &child : static_cast<const sexp_list_t &>(obj)) {
+            if (!child)
+                sexp_error(sexp_exception_t::error, "List has a null element", 0, 0, EOF);
+            res->push_back(from_object(*child));
+        }
+        return res;
+    }
+    if (obj.get_kind() != sexp_object_t::string_kind || typeid(obj) != typeid(sexp_string_t))
+        sexp_error(sexp_exception_t::error, "Object cannot be converted", 0, 0, EOF);
+
+    const sexp_string_t &src = static_cast<const sexp_string_t &>(obj);
+    sexp_simple_string_t data(src.get_string());
+    if (!src.has_presentation_hint())
+        return ptr_t(new sexp_ref_string_t<Count>(std::move(data)));
+    sexp_simple_string_t hint(src.get_presentation_hint());
+    return ptr_t(new sexp_ref_string_t<Count>(std::move(hint), std::move(data)));
+}
+
+/*
+ * sexp_ref_object_t::scan(sis)
+ * Follows sexp_input_stream_t::scan_object(), sexp_string_t::parse() and
+ * sexp_list_t::parse().
+ */
+template <typename Count>
+typename sexp_ref_object_t<Count>::ptr_t sexp_ref_object_t<Count>::scan(
+  sexp_input_stream_t *sis)
+{
+    sis->skip_white_space();
+    if (sis->get_next_char() == '{' && sis->get_byte_size() != 6) {
+        sis->set_byte_size(6)->skip_char('{');
+        ptr_t res = scan(sis);
+        sis->skip_char('}');
+        return res;
+    }
+    if (sis->get_next_char() == '(') {
+        sexp_intrusive_ptr_t<sexp_ref_list_t<Count>> res(new sexp_ref_list_t<Count>());
+        sis->open_list()->skip_white_space();
+        while (sis->get_next_char() != ')') {
+            res->push_back(scan(sis));
+            sis->skip_white_space();
+        }
+        sis->close_list();
+        return res;
+    }
+    if (sis->get_next_char() != '[')
+        return ptr_t(new sexp_ref_string_t<Count>(sis->scan_simple_string()));
+    sis->skip_char('[');
+    sexp_simple_string_t hint = sis->scan_simple_string();
+    sis->skip_white_space()->skip_char(']')->skip_white_space();
+    return ptr_t(new sexp_ref_string_t<Count>(std::move(hint), sis->scan_simple_string()));
+}
+
+typedef sexp_ref_object_t<sexp_atomic_refcount_t> sexp_shared_ref_object_t;
+typedef sexp_ref_object_t<sexp_local_refcount_t>  sexp_local_ref_object_t;
+
+} // namespace sexp
@@ -0,0 +1,199 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <functional>
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * In-memory source and sink
+ * The memory source reads a buffer in place; the buffer must stay alive while the
+ * source is in use.  The memory sink accumulates output in a string.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_memory_source_t : public sexp_byte_source_t {
+  protected:
+    virtual bool fill(void) { return false; }
+
+  public:
+    sexp_memory_source_t(const octet_t *bt, size_t ln)
+    {
+        next = bt;
+        last = bt + ln;
+    }
+    sexp_memory_source_t(const char *bt, size_t ln)
+        : sexp_memory_source_t(reinterpret_cast<const octet_t *>(bt), ln)
+    {
+    }
+    sexp_memory_source_t(const std::string &s) : sexp_memory_source_t(s.data(), s.size()) {}
+
+    size_t remaining(void) const noexcept { return last - next; }
+};
+
+class SEXP_PUBLIC_SYMBOL sexp_memory_sink_t : public sexp_byte_sink_t {
+  protected:
+    std::string buffer;
+
+  public:
+    virtual void put(octet_t c) { buffer.push_back((char) c); }
+    virtual void write(const octet_t *bt, size_t ln)
+    {
+        buffer.append(reinterpret_cast<const char *>(bt), ln);
+    }
+
+    const std::string &str(void) const noexcept { return buffer; }
+    void               clear(void) noexcept { buffer.clear(); }
+};
+
+/*
+ * Buffered source and sink
+ * Base classes for sources and sinks that move data in blocks: derived classes
+ * implement read_some() or drain(), the buffering is done here.  Buffered sinks
+ * must be flushed (derived classes flush on destruction) to deliver the tail.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_buffered_source_t : public sexp_byte_source_t {
+  protected:
+    std::vector<octet_t> buffer;
+
+    virtual bool fill(void);
+    /* Reads up to ln bytes into bt, returns 0 at the end of input */
+    virtual size_t read_some(octet_t *bt, size_t ln) = 0;
+
+  public:
+    static const size_t DEFAULT_BUFFER_SIZE = 16384;
+
+    sexp_buffered_source_t(size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : buffer(buffer_size ? buffer_size : 1)
+    {
+    }
+};
+
+class SEXP_PUBLIC_SYMBOL sexp_buffered_sink_t : public sexp_byte_sink_t {
+  protected:
+    std::vector<octet_t> buffer;
+    size_t               used;
+
+    /* Delivers ln bytes at bt */
+    virtual void drain(const octet_t *bt, size_t ln) = 0;
+
+  public:
+    static const size_t DEFAULT_BUFFER_SIZE = 16384;
+
+    sexp_buffered_sink_t(size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : buffer(buffer_size ? buffer_size : 1), used(0)
+    {
+    }
+
+    virtual void put(octet_t c)
+    {
+        if (used == buffer.size())
+            flush();
+        buffer[used++] = c;
+    }
+    virtual void write(const octet_t *bt, size_t ln);
+    virtual void flush(void);
+};
+
+/*
+ * Callback source and sink
+ * Pass data to and from user-provided functions, e.g. to parse from or serialize to
+ * a network connection or a custom I/O layer.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_callback_source_t : public sexp_buffered_source_t {
+  public:
+    /* Reads up to ln bytes into bt, returns number of bytes read, 0 at the end */
+    typedef std::function<size_t(octet_t *bt, size_t ln)> reader_t;
+
+  protected:
+    reader_t reader;
+
+    virtual size_t read_some(octet_t *bt, size_t ln) { return reader(bt, ln); }
+
+  public:
+    sexp_callback_source_t(reader_t r, size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : sexp_buffered_source_t(buffer_size), reader(std::move(r))
+    {
+    }
+};
+
+class SEXP_PUBLIC_SYMBOL sexp_callback_sink_t : public sexp_buffered_sink_t {
+  public:
+    typedef std::function<void(const octet_t *bt, size_t ln)> writer_t;
+
+  protected:
+    writer_t writer;
+
+    virtual void drain(const octet_t *bt, size_t ln) { writer(bt, ln); }
+
+  public:
+    sexp_callback_sink_t(writer_t w, size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : sexp_buffered_sink_t(buffer_size), writer(std::move(w))
+    {
+    }
+    virtual ~sexp_callback_sink_t();
+};
+
+#ifndef _WIN32
+/*
+ * File descriptor source and sink
+ * Read and write blocking file descriptors with read(2)/write(2).  Interrupted
+ * calls are restarted, other errors are reported with sexp_error.  Descriptors
+ * are not closed.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_fd_source_t : public sexp_buffered_source_t {
+  protected:
+    int fd;
+
+    virtual size_t read_some(octet_t *bt, size_t ln);
+
+  public:
+    sexp_fd_source_t(int f, size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : sexp_buffered_source_t(buffer_size), fd(f)
+    {
+    }
+};
+
+class SEXP_PUBLIC_SYMBOL sexp_fd_sink_t : public sexp_buffered_sink_t {
+  protected:
+    int fd;
+
+    virtual void drain(const octet_t *bt, size_t ln);
+
+  public:
+    sexp_fd_sink_t(int f, size_t buffer_size = DEFAULT_BUFFER_SIZE)
+        : sexp_buffered_sink_t(buffer_size), fd(f)
+    {
+    }
+    virtual ~sexp_fd_sink_t();
+};
+#endif
+
+} // namespace sexp
@@ -0,0 +1,85 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP scatter-gather canonical output
+ * Canonical image of an object as a sequence of segments.  Length prefixes,
+ * parentheses and short atoms are generated into an internal buffer, longer atoms
+ * are referenced in place, so payload bytes are not copied.  Referenced atoms must
+ * stay alive and unchanged while segments are in use.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_iovec_t : sexp_depth_manager {
+  public:
+    /* Atoms shorter than this are copied into the generated buffer */
+    static const size_t DEFAULT_INLINE_LIMIT = 64;
+
+    struct segment_t {
+        const octet_t *data;
+        size_t         length;
+    };
+
+  private:
+    struct part_t {
+        const octet_t *data;   /* referenced atom, or nullptr for generated bytes */
+        size_t         offset; /* offset of generated bytes in headers */
+        size_t         length;
+    };
+
+    octet_string        headers;      /* generated bytes */
+    std::vector<part_t> parts;        /* segments in output order */
+    size_t              total;        /* total length of the image */
+    size_t              inline_limit; /* atoms shorter than this are copied */
+
+    void put_generated(const octet_t *bt, size_t ln);
+    void put_char(int c);
+    void put_simple_string(const sexp_simple_string_t &ss);
+    void put_object(const sexp_object_t &obj);
+
+  public:
+    sexp_iovec_t(size_t i_limit = DEFAULT_INLINE_LIMIT,
+                 size_t max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+
+    sexp_iovec_t *add(const sexp_object_t &obj);
+    sexp_iovec_t *add(const std::shared_ptr<sexp_object_t> &obj) { return add(*obj); }
+    sexp_iovec_t *clear(void);
+
+    size_t                 size(void) const noexcept { return total; }
+    size_t                 count(void) const noexcept { return parts.size(); }
+    std::vector<segment_t> segments(void) const;
+    octet_string           str(void) const;
+
+#ifndef _WIN32
+    /* Writes all segments to file descriptor fd with writev(2), returns bytes written */
+    size_t writev(int fd) const;
+#endif
+};
+
+} // namespace sexp
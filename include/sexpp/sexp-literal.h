@@ -0,0 +1,394 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp-public.h"
+#include "sexp.h"
+#include "sexp-io.h"
+
+/* Literals need relaxed constexpr functions */
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define SEXP_WITH_LITERALS
+#endif
+
+#ifdef SEXP_WITH_LITERALS
+
+namespace sexp {
+
+/*
+ * SEXP literals
+ * A literal holds the canonical image of an S-expression written in advanced or
+ * canonical syntax, e.g.
+ *
+ *   static constexpr auto skeleton = sexp_literal("(public-key (rsa (n) (e)))");
+ *
+ * When the literal initializes a constexpr variable the text is parsed and encoded
+ * by the compiler: the image is static data and malformed text does not compile.
+ * Otherwise it is parsed at run time and errors are reported with sexp_error.
+ * The syntax is the one sexp_input_stream_t reads, except the transport encoding
+ * {...}, and declared lengths that do not match are errors rather than warnings.
+ */
+
+/*
+ * sexp_literal_error(msg, pos)
+ * Not constexpr: reached at compile time it makes the literal ill-formed.
+ */
+inline void sexp_literal_error(const char *msg, size_t pos)
+{
+    sexp_error(sexp_exception_t::error, msg, 0, 0, (int) pos);
+}
+
+template <size_t Capacity> class sexp_literal_t {
+  private:
+    /* Room for the length prefix of an atom, which is written after the atom */
+    static constexpr size_t PREFIX_ROOM = 11;
+
+    octet_t bytes[Capacity];
+    size_t  length;
+
+    static constexpr bool is_white_space(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+    static constexpr bool is_dec_digit(char c) { return c >= '0' && c <= '9'; }
+    /* same set as sexp_char_defs_t::tokenchar */
+    static constexpr bool is_token_char(char c)
+    {
+        return is_dec_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+               c == '*' || c == '+' || c == '-' || c == '.' || c == '/' || c == ':' ||
+               c == '=' || c == '_';
+    }
+    static constexpr int hex_value(char c)
+    {
+        return is_dec_digit(c)         ? c - '0' :
+               (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+               (c >= 'A' && c <= 'F') ? c - 'A' + 10 :
+                                        -1;
+    }
+    static constexpr int base64_value(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? c - 'A' :
+               (c >= 'a' && c <= 'z') ? c - 'a' + 26 :
+               is_dec_digit(c)        ? c - '0' + 52 :
+               c == '+'               ? 62 :
+               c == '/'               ? 63 :
+                                        -1;
+    }
+    static constexpr size_t skip_white_space(const char *text, size_t n, size_t pos)
+    {
+        while (pos < n && is_white_space(text[pos]))
+            pos++;
+        return pos;
+    }
+    /* Returns the character at pos, reports the end of text */
+    static constexpr char at(const char *text, size_t n, size_t pos)
+    {
+        if (pos >= n)
+            sexp_literal_error("unexpected end of literal", pos);
+        return text[pos];
+    }
+
+    constexpr void put(octet_t c)
+    {
+        if (length >= Capacity)
+            sexp_literal_error("literal image is too long", length);
+        bytes[length++] = c;
+    }
+
+    constexpr size_t scan_quoted(const char *text, size_t n, size_t pos);
+    constexpr size_t scan_hexadecimal(const char *text, size_t n, size_t pos);
+    constexpr size_t scan_base64(const char *text, size_t n, size_t pos);
+    constexpr size_t scan_simple_string(const char *text, size_t n, size_t pos);
+    constexpr size_t scan_string(const char *text, size_t n, size_t pos);
+
+  public:
+    constexpr sexp_literal_t(const char *text, size_t n);
+
+    constexpr const octet_t *data(void) const noexcept { return bytes; }
+    constexpr size_t         size(void) const noexcept { return length; }
+
+    sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const
+    {
+        return os->var_put_chars(bytes, length);
+    }
+    /* Builds the object, for code that needs a tree */
+    std::shared_ptr<sexp_object_t> to_object(void) const
+    {
+        sexp_memory_source_t source(bytes, length);
+        sexp_input_stream_t  sis(&source);
+        return sis.set_byte_size(8)->get_char()->scan_object();
+    }
+};
+
+/*
+ * sexp_literal(text)
+ * The canonical image is never more than twice as long as the text.
+ */
+template <size_t N> constexpr sexp_literal_t<2 * N + 12> sexp_literal(const char (&text)[N])
+{
+    return sexp_literal_t<2 * N + 12>(text, N - 1);
+}
+
+/*
+ * sexp_literal_t::sexp_literal_t(text, n)
+ * Encodes exactly one object from n characters of text
+ */
+template <size_t Capacity>
+constexpr sexp_literal_t<Capacity>::sexp_literal_t(const char *text, size_t n)
+    : bytes{}, length(0)
+{
+    size_t depth = 0;
+    bool   done = false;
+    size_t pos = skip_white_space(text, n, 0);
+    while (pos < n) {
+        if (done)
+            sexp_literal_error("literal holds more than one object", pos);
+        if (text[pos] == '(') {
+            put('(');
+            depth++;
+            pos++;
+        } else if (text[pos] == ')') {
+            if (depth == 0)
+                sexp_literal_error("unbalanced ')'", pos);
+            put(')');
+            done = --depth == 0;
+            pos++;
+        } else {
+            pos = scan_string(text, n, pos);
+            done = depth == 0;
+        }
+        pos = skip_white_space(text, n, pos);
+    }
+    if (!done)
+        sexp_literal_error("unexpected end of literal", pos);
+}
+
+/*
+ * sexp_literal_t::scan_string(text, n, pos)
+ * Encodes a simple string with optional presentation hint
+ */
+template <size_t Capacity>
+constexpr size_t sexp_literal_t<Capacity>::scan_string(const char *text, size_t n, size_t pos)
+{
+    if (text[pos] == '[') {
+        put('[');
+        pos = scan_simple_string(text, n, skip_white_space(text, n, pos + 1));
+        pos = skip_white_space(text, n, pos);
+        if (at(text, n, pos) != ']')
+            sexp_literal_error("']' expected", pos);
+        put(']');
+        pos = skip_white_space(text, n, pos + 1);
+    }
+    return scan_simple_string(text, n, pos);
+}
+
+/*
+ * sexp_literal_t::scan_simple_string(text, n, pos)
+ * Decodes the string after room for its length prefix, then writes the prefix and
+ * moves the string next to it.
+ */
+template <size_t Capacity>
+constexpr size_t sexp_literal_t<Capacity>::scan_simple_string(const char *text,
+                                                              size_t      n,
+                                                              size_t      pos)
+{
+    size_t start = length;
+    for (size_t i = 0; i < PREFIX_ROOM; i++)
+        put(0);
+
+    char c = at(text, n, pos);
+    if (is_token_char(c) && !is_dec_digit(c)) {
+        while (pos < n && is_token_char(text[pos]))
+            put(text[pos++]);
+    } else {
+        bool   declared = is_dec_digit(c);
+        size_t declared_length = 0;
+        while (pos < n && is_dec_digit(text[pos])) {
+            declared_length = declared_length * 10 + (text[pos++] - '0');
+            if (declared_length > n)
+                sexp_literal_error("declared length exceeds the literal", pos);
+        }
+        switch (at(text, n, pos)) {
+        case '"':
+            pos = scan_quoted(text, n, pos + 1);
+            break;
+        case '#':
+            pos = scan_hexadecimal(text, n, pos + 1);
+            break;
+        case '|':
+            pos = scan_base64(text, n, pos + 1);
+            break;
+        default:
+            if (!declared || at(text, n, pos) != ':')
+                sexp_literal_error("illegal character", pos);
+            pos++;
+            for (size_t i = 0; i < declared_length; i++)
+                put(at(text, n, pos++));
+        }
+        if (declared && length - start - PREFIX_ROOM != declared_length)
+            sexp_literal_error("string length differs from declared length", pos);
+    }
+
+    size_t ln = length - start - PREFIX_ROOM;
+    size_t digits = 1;
+    for (size_t v = ln; v >= 10; v /= 10)
+        digits++;
+    size_t v = ln;
+    for (size_t i = digits; i > 0; i--, v /= 10)
+        bytes[start + i - 1] = octet_t('0' + v % 10);
+    bytes[start + digits] = ':';
+    for (size_t i = 0; i < ln; i++)
+        bytes[start + digits + 1 + i] = bytes[start + PREFIX_ROOM + i];
+    length = start + digits + 1 + ln;
+    return pos;
+}
+
+/*
+ * sexp_literal_t::scan_quoted(text, n, pos)
+ * Same escapes as sexp_input_stream_t::scan_quoted_string()
+ */
+template <size_t Capacity>
+constexpr size_t sexp_literal_t<Capacity>::scan_quoted(const char *text, size_t n, size_t pos)
+{
+    while (at(text, n, pos) != '"') {
+        char c = text[pos++];
+        if (c != '\\') {
+            put(octet_t(c));
+            continue;
+        }
+        c = at(text, n, pos++);
+        switch (c) {
+        case 'b':
+            put('\b');
+            break;
+        case 't':
+            put('\t');
+            break;
+        case 'v':
+            put('\v');
+            break;
+        case 'n':
+            put('\n');
+            break;
+        case 'f':
+            put('\f');
+            break;
+        case 'r':
+            put('\r');
+            break;
+        case '"':
+        case '\'':
+        case '\\':
+            put(octet_t(c));
+            break;
+        case 'x': {
+            int high = hex_value(at(text, n, pos));
+            int low = hex_value(at(text, n, pos + 1));
+            if (high < 0 || low < 0)
+                sexp_literal_error("hex character too short", pos);
+            put(octet_t(high << 4 | low));
+            pos += 2;
+        } break;
+        case '\n': /* line continuation, with optional following '\r' */
+        case '\r':
+            if (pos < n && (text[pos] == '\n' || text[pos] == '\r') && text[pos] != c)
+                pos++;
+            break;
+        default: {
+            if (c < '0' || c > '7')
+                sexp_literal_error("unknown escape sequence", pos);
+            unsigned val = 0;
+            for (size_t i = 0; i < 3; i++) {
+                char d = at(text, n, pos - 1 + i);
+                if (d < '0' || d > '7')
+                    sexp_literal_error("octal character too short", pos);
+                val = val << 3 | unsigned(d - '0');
+            }
+            if (val > 255)
+                sexp_literal_error("octal character too big", pos);
+            put(octet_t(val));
+            pos += 2;
+        }
+        }
+    }
+    return pos + 1;
+}
+
+/*
+ * sexp_literal_t::scan_hexadecimal(text, n, pos)
+ */
+template <size_t Capacity>
+constexpr size_t sexp_literal_t<Capacity>::scan_hexadecimal(const char *text,
+                                                            size_t      n,
+                                                            size_t      pos)
+{
+    unsigned bits = 0;
+    size_t   n_bits = 0;
+    for (char c = at(text, n, pos); c != '#'; c = at(text, n, ++pos)) {
+        if (is_white_space(c))
+            continue;
+        if (hex_value(c) < 0)
+            sexp_literal_error("illegal character in hexadecimal string", pos);
+        bits = bits << 4 | unsigned(hex_value(c));
+        n_bits += 4;
+        if (n_bits == 8) {
+            put(octet_t(bits));
+            bits = 0;
+            n_bits = 0;
+        }
+    }
+    if (n_bits != 0)
+        sexp_literal_error("odd number of hexadecimal digits", pos);
+    return pos + 1;
+}
+
+/*
+ * sexp_literal_t::scan_base64(text, n, pos)
+ */
+template <size_t Capacity>
+constexpr size_t sexp_literal_t<Capacity>::scan_base64(const char *text, size_t n, size_t pos)
+{
+    unsigned bits = 0;
+    size_t   n_bits = 0;
+    for (char c = at(text, n, pos); c != '|'; c = at(text, n, ++pos)) {
+        if (is_white_space(c) || c == '=')
+            continue;
+        if (base64_value(c) < 0)
+            sexp_literal_error("illegal character in base64 string", pos);
+        bits = bits << 6 | unsigned(base64_value(c));
+        n_bits += 6;
+        if (n_bits >= 8) {
+            n_bits -= 8;
+            put(octet_t(bits >> n_bits));
+            bits &= (1u << n_bits) - 1;
+        }
+    }
+    if (bits != 0)
+        sexp_literal_error("base64 string ends with unused bits", pos);
+    return pos + 1;
+}
+
+} // namespace sexp
+
+#endif // SEXP_WITH_LITERALS
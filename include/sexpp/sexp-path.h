@@ -0,0 +1,93 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP path query
+ * A path is compiled once and then evaluated against trees or canonical images.
+ * Steps are separated by '/' and name the leading token of a list:
+ *     private-key/rsa/n   root list (private-key ...), its child (rsa ...), then
+ *                         the child (n ...) of that
+ *     //protected-at      list (protected-at ...) at any depth, the root included
+ * A step '*' matches any list; "//" lets the next step match at any depth below
+ * the current list.  Matches are reported in document order, the first one is the
+ * list that starts first in the image.  Presentation hints of leading tokens are not
+ * compared.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_path_t {
+  public:
+    /* Up to this many steps in a path */
+    static const size_t MAX_STEPS = 63;
+
+    /* Bytes of a canonical image */
+    struct span_t {
+        const octet_t *data;
+        size_t         length;
+    };
+
+  private:
+    struct step_t {
+        std::string token;      /* leading token to match */
+        bool        any;        /* '*': any list matches */
+        bool        descendant; /* step follows "//" */
+    };
+
+    std::string         path;
+    std::vector<step_t> steps;
+
+    uint64_t advance(uint64_t active, const octet_t *token, size_t length, bool &matched) const;
+    bool     search(const sexp_list_t &                list,
+                    uint64_t                           active,
+                    std::vector<const sexp_list_t *> *all,
+                    const sexp_list_t **               first) const;
+
+  public:
+    sexp_path_t(const std::string &p);
+
+    const std::string &str(void) const noexcept { return path; }
+    size_t             size(void) const noexcept { return steps.size(); }
+
+    /* Returns the first matching list in the tree, nullptr if there is none */
+    const sexp_list_t *find(const sexp_object_t &root) const;
+    /* Returns all matching lists in the tree in document order */
+    std::vector<const sexp_list_t *> find_all(const sexp_object_t &root) const;
+    /* Returns the string that follows the leading token of the first matching list,
+     * e.g. the value of (n |...|), nullptr if there is none */
+    const sexp_simple_string_t *value(const sexp_object_t &root) const;
+
+    /* Same as find() for the canonical image at bt: sets list to the image of the
+     * first matching list.  Malformed images are reported with sexp_error. */
+    bool find(const octet_t *bt, size_t ln, span_t &list) const;
+    /* Same as value() for the canonical image at bt: sets atom to the bytes of the
+     * string, without the length prefix */
+    bool value(const octet_t *bt, size_t ln, span_t &atom) const;
+};
+
+} // namespace sexp
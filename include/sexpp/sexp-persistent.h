@@ -0,0 +1,89 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP persistent tree
+ * An immutable tree that is updated by path copying: an update returns a new tree in
+ * which the lists on the way from the root to the updated element are copied and all
+ * other nodes are shared with the original tree.  A copied list holds pointers to the
+ * elements, so an update copies depth lists and no atoms.
+ *
+ * Nodes are never modified once they are in a persistent tree, so any number of
+ * threads may read a tree and derive new trees from it without locking.  The tree
+ * handle itself is a value; threads shall use their own copies of it.  The tree given
+ * to the constructor is taken over and shall not be modified afterwards.
+ *
+ * Elements are addressed by paths of positions: path {2, 0} is the first element of
+ * the third element of the root list, the empty path is the root.  Invalid paths are
+ * reported with sexp_error, and so are paths that lead through a list of a class
+ * derived from sexp_list_t, which cannot be copied without losing its overrides.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_persistent_t {
+  public:
+    typedef std::shared_ptr<const sexp_object_t> node_t;
+    typedef std::vector<size_t>                  path_t;
+
+  private:
+    enum operation_t { op_set, op_insert, op_erase };
+
+    node_t root_node;
+
+    static node_t update(const node_t &node,
+                         const path_t &path,
+                         size_t        depth,
+                         operation_t   op,
+                         const node_t &value);
+
+  public:
+    sexp_persistent_t(void) = default;
+    explicit sexp_persistent_t(node_t root) : root_node(std::move(root)) {}
+
+    const node_t &root(void) const noexcept { return root_node; }
+    bool          empty(void) const noexcept { return !root_node; }
+
+    /* Returns the element at path, nullptr if there is none */
+    node_t at(const path_t &path) const;
+    /* Finds the path to the list that is reached by descending through child lists with
+     * the given leading tokens, e.g. {"private-key", "rsa", "n"}; the first token names
+     * the root.  Presentation hints are not compared.  Returns false if there is no
+     * such list. */
+    bool locate(const std::vector<std::string> &tokens, path_t &path) const;
+
+    /* Returns the tree with the element at path replaced by value */
+    sexp_persistent_t set(const path_t &path, node_t value) const;
+    /* Returns the tree with value inserted before the element at path; the last
+     * position may be the size of the list to append to it */
+    sexp_persistent_t insert(const path_t &path, node_t value) const;
+    /* Returns the tree without the element at path */
+    sexp_persistent_t erase(const path_t &path) const;
+};
+
+} // namespace sexp
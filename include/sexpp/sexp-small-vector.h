@@ -0,0 +1,713 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <iterator>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+namespace sexp {
+
+/*
+ * Vector with inline storage
+ * Keeps up to N elements inside the object and moves them to the heap when it
+ * grows beyond that.  The interface follows std::vector; references to elements are
+ * invalidated by operations that change capacity, and additionally by moving or
+ * swapping a container that uses inline storage.  Iterators refer to positions, so
+ * they stay valid while the container grows.
+ * With a segment size set (see set_segment_size()), a vector that grows beyond it
+ * keeps its elements in separately allocated segments of that size.  Elements in
+ * segments are never moved and growth allocates one segment at a time, so very wide
+ * vectors do not reallocate and move everything; data() is nullptr then.
+ * Elements must be nothrow move constructible.
+ */
+
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+class sexp_small_vector_t : private Allocator {
+    static_assert(N > 0 && N <= UINT32_MAX, "inline capacity is out of range");
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "elements must be nothrow move constructible");
+
+    typedef std::allocator_traits<Allocator>                  alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<T *> directory_allocator;
+    typedef std::allocator_traits<directory_allocator>        directory_traits;
+
+    /* Random access iterator over positions, V is T or const T */
+    template <typename V> class position_iterator_t {
+        template <typename> friend class position_iterator_t;
+
+        const sexp_small_vector_t *owner;
+        size_t                     pos;
+
+      public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef ptrdiff_t                       difference_type;
+        typedef V *                             pointer;
+        typedef V &                             reference;
+
+        position_iterator_t(void) noexcept : owner(nullptr), pos(0) {}
+        position_iterator_t(const sexp_small_vector_t *o, size_t p) noexcept : owner(o), pos(p)
+        {
+        }
+        /* iterator converts to const_iterator */
+        position_iterator_t(const position_iterator_t<T> &it) noexcept
+            : owner(it.owner), pos(it.pos)
+        {
+        }
+
+        reference operator*(void) const noexcept { return *owner->slot(pos); }
+        pointer   operator->(void) const noexcept { return owner->slot(pos); }
+        reference operator[](difference_type n) const noexcept
+        {
+            return *owner->slot(pos + n);
+        }
+
+        position_iterator_t &operator++(void) noexcept
+        {
+            ++pos;
+            return *this;
+        }
+        position_iterator_t operator++(int) noexcept
+        {
+            return position_iterator_t(owner, pos++);
+        }
+        position_iterator_t &operator--(void) noexcept
+        {
+            --pos;
+            return *this;
+        }
+        position_iterator_t operator--(int) noexcept
+        {
+            return position_iterator_t(owner, pos--);
+        }
+        position_iterator_t &operator+=(difference_type n) noexcept
+        {
+            pos += n;
+            return *this;
+        }
+        position_iterator_t &operator-=(difference_type n) noexcept
+        {
+            pos -= n;
+            return *this;
+        }
+
+        friend position_iterator_t operator+(const position_iterator_t &it, difference_type n)
+        {
+            return position_iterator_t(it.owner, it.pos + n);
+        }
+        friend position_iterator_t operator+(difference_type n, const position_iterator_t &it)
+        {
+            return position_iterator_t(it.owner, it.pos + n);
+        }
+        friend position_iterator_t operator-(const position_iterator_t &it, difference_type n)
+        {
+            return position_iterator_t(it.owner, it.pos - n);
+        }
+        friend difference_type operator-(const position_iterator_t &left,
+                                         const position_iterator_t &right)
+        {
+            return (difference_type) left.pos - (difference_type) right.pos;
+        }
+        friend bool operator==(const position_iterator_t &left,
+                               const position_iterator_t &right)
+        {
+            return left.pos == right.pos;
+        }
+        friend bool operator!=(const position_iterator_t &left,
+                               const position_iterator_t &right)
+        {
+            return left.pos != right.pos;
+        }
+        friend bool operator<(const position_iterator_t &left,
+                              const position_iterator_t &right)
+        {
+            return left.pos < right.pos;
+        }
+        friend bool operator>(const position_iterator_t &left,
+                              const position_iterator_t &right)
+        {
+            return left.pos > right.pos;
+        }
+        friend bool operator<=(const position_iterator_t &left,
+                               const position_iterator_t &right)
+        {
+            return left.pos <= right.pos;
+        }
+        friend bool operator>=(const position_iterator_t &left,
+                               const position_iterator_t &right)
+        {
+            return left.pos >= right.pos;
+        }
+    };
+
+  public:
+    typedef T                                     value_type;
+    typedef Allocator                             allocator_type;
+    typedef size_t                                size_type;
+    typedef ptrdiff_t                             difference_type;
+    typedef T &                                   reference;
+    typedef const T &                             const_reference;
+    typedef T *                                   pointer;
+    typedef const T *                             const_pointer;
+    typedef position_iterator_t<T>                iterator;
+    typedef position_iterator_t<const T>          const_iterator;
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static const size_type inline_capacity = N;
+
+  private:
+    union {
+        T * first;     /* contiguous elements, either inline_data or heap */
+        T **directory; /* segments, if segmented */
+    };
+    uint32_t count;     /* number of elements */
+    uint32_t reserved;  /* capacity, N while inline */
+    uint32_t changes;   /* see version() */
+    uint8_t  shift;     /* log2 of the segment size, 0 if segments are not used */
+    bool     segmented; /* elements are kept in segments */
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_data[N];
+
+    T *  inline_begin(void) noexcept { return reinterpret_cast<T *>(inline_data); }
+    bool is_inline(void) const noexcept
+    {
+        return !segmented && first == reinterpret_cast<const T *>(inline_data);
+    }
+    Allocator &alloc(void) noexcept { return *this; }
+
+    /* Address of the element at pos, pos <= capacity() */
+    T *slot(size_type pos) const noexcept
+    {
+        if (segmented)
+            return directory[pos >> shift] + (pos & (((size_type) 1 << shift) - 1));
+        return first + pos;
+    }
+
+    /* Directory of n segments has room for max(4, smallest power of two >= n) */
+    static size_type directory_capacity(size_type n) noexcept
+    {
+        size_type cap = 4;
+        while (cap < n)
+            cap *= 2;
+        return cap;
+    }
+    /* Replaces the directory of n segments by one with room for keep <= n segments,
+     * releasing segments beyond keep */
+    void move_directory(size_type n, size_type keep, size_type cap)
+    {
+        directory_allocator da(alloc());
+        T **                dir = directory_traits::allocate(da, cap);
+        std::copy(directory, directory + keep, dir);
+        std::swap(dir, directory);
+        for (size_type i = keep; i < n; i++)
+            alloc_traits::deallocate(alloc(), dir[i], (size_type) 1 << shift);
+        directory_traits::deallocate(da, dir, directory_capacity(n));
+    }
+    void add_segment(void)
+    {
+        size_type n = reserved >> shift;
+        T *       segment = alloc_traits::allocate(alloc(), (size_type) 1 << shift);
+        if (n == directory_capacity(n)) {
+            try {
+                move_directory(n, n, directory_capacity(n + 1));
+            } catch (...) {
+                alloc_traits::deallocate(alloc(), segment, (size_type) 1 << shift);
+                throw;
+            }
+        }
+        directory[n] = segment;
+        reserved += (uint32_t) 1 << shift;
+    }
+    /* Moves contiguous elements into segments; a heap block of exactly one segment is
+     * taken over as the first segment without moving its elements */
+    void segment_storage(void)
+    {
+        size_type           seg = (size_type) 1 << shift;
+        size_type           n = std::max<size_type>((count + seg - 1) >> shift, 1);
+        bool                adopt = !is_inline() && reserved == seg;
+        directory_allocator da(alloc());
+        T **                dir = directory_traits::allocate(da, directory_capacity(n));
+        size_type           made = 0;
+        try {
+            for (; made < n; made++)
+                dir[made] = adopt && !made ? first : alloc_traits::allocate(alloc(), seg);
+        } catch (...) {
+            for (size_type i = adopt ? 1 : 0; i < made; i++)
+                alloc_traits::deallocate(alloc(), dir[i], seg);
+            directory_traits::deallocate(da, dir, directory_capacity(n));
+            throw;
+        }
+        if (!adopt) {
+            for (uint32_t i = 0; i < count; i++) {
+                alloc_traits::construct(
+                  alloc(), dir[i >> shift] + (i & (seg - 1)), std::move(first[i]));
+                alloc_traits::destroy(alloc(), first + i);
+            }
+            if (!is_inline())
+                alloc_traits::deallocate(alloc(), first, reserved);
+        }
+        directory = dir;
+        reserved = (uint32_t) (n << shift);
+        segmented = true;
+    }
+
+    void destroy_all(void) noexcept
+    {
+        for (uint32_t i = 0; i < count; i++)
+            alloc_traits::destroy(alloc(), slot(i));
+        count = 0;
+        changes++;
+    }
+    void release(void) noexcept
+    {
+        destroy_all();
+        if (segmented) {
+            size_type n = reserved >> shift;
+            for (size_type i = 0; i < n; i++)
+                alloc_traits::deallocate(alloc(), directory[i], (size_type) 1 << shift);
+            directory_allocator da(alloc());
+            directory_traits::deallocate(da, directory, directory_capacity(n));
+            segmented = false;
+        } else if (!is_inline())
+            alloc_traits::deallocate(alloc(), first, reserved);
+        first = inline_begin();
+        reserved = N;
+    }
+    /* Moves contiguous elements to a new block of exactly cap elements, cap >= count */
+    void relocate(size_type cap)
+    {
+        T *block = cap > N ? alloc_traits::allocate(alloc(), cap) : inline_begin();
+        if (block == first)
+            return;
+        for (uint32_t i = 0; i < count; i++) {
+            alloc_traits::construct(alloc(), block + i, std::move(first[i]));
+            alloc_traits::destroy(alloc(), first + i);
+        }
+        if (!is_inline())
+            alloc_traits::deallocate(alloc(), first, reserved);
+        first = block;
+        reserved = (uint32_t) (cap > N ? cap : N);
+    }
+    /* Makes room for need elements, exactly if exact, otherwise geometrically */
+    void expand(size_type need, bool exact)
+    {
+        if (need > max_size())
+            throw std::length_error("sexp_small_vector_t: too many elements");
+        if (!segmented && shift && need > ((size_type) 1 << shift))
+            segment_storage();
+        if (segmented) {
+            while (reserved < need)
+                add_segment();
+            return;
+        }
+        size_type cap = exact ? need : std::min(max_size(), (size_type) reserved * 2);
+        if (shift)
+            cap = std::min(cap, (size_type) 1 << shift);
+        relocate(std::max(need, cap));
+    }
+    void grow(size_type need) { expand(need, false); }
+    /* Takes elements and the segment size from other, which is left empty */
+    void steal(sexp_small_vector_t &other) noexcept
+    {
+        changes++;
+        other.changes++;
+        shift = other.shift;
+        if (other.is_inline()) {
+            for (uint32_t i = 0; i < other.count; i++) {
+                alloc_traits::construct(alloc(), first + i, std::move(other.first[i]));
+                alloc_traits::destroy(other.alloc(), other.first + i);
+            }
+            count = other.count;
+            other.count = 0;
+            return;
+        }
+        if (other.segmented)
+            directory = other.directory;
+        else
+            first = other.first;
+        segmented = other.segmented;
+        count = other.count;
+        reserved = other.reserved;
+        other.segmented = false;
+        other.first = other.inline_begin();
+        other.count = 0;
+        other.reserved = N;
+    }
+
+    void move_assign(sexp_small_vector_t &other, std::true_type) noexcept
+    {
+        release();
+        alloc() = other.alloc();
+        steal(other);
+    }
+    void move_assign(sexp_small_vector_t &other, std::false_type)
+    {
+        if (alloc() == other.alloc()) {
+            release();
+            steal(other);
+            return;
+        }
+        /* memory of other cannot be taken over, move elements one by one */
+        clear();
+        reserve(other.count);
+        for (auto &value : other)
+            emplace_back(std::move(value));
+        other.clear();
+    }
+
+    template <typename InputIt>
+    void append_range(InputIt b, InputIt e, std::input_iterator_tag)
+    {
+        for (; b != e; ++b)
+            emplace_back(*b);
+    }
+    /* [b, e) may refer to elements of this vector, so it is copied before growing the
+     * storage */
+    template <typename ForwardIt>
+    void append_range(ForwardIt b, ForwardIt e, std::forward_iterator_tag)
+    {
+        size_type n = std::distance(b, e);
+        if (count + n <= reserved) {
+            for (; b != e; ++b)
+                emplace_back(*b);
+            return;
+        }
+        sexp_small_vector_t tmp(b, e, get_allocator());
+        reserve(count + n);
+        for (auto &value : tmp)
+            emplace_back(std::move(value));
+    }
+
+  public:
+    explicit sexp_small_vector_t(const Allocator &a = Allocator()) noexcept
+        : Allocator(a), first(inline_begin()), count(0), reserved(N), changes(0), shift(0),
+          segmented(false)
+    {
+    }
+    explicit sexp_small_vector_t(size_type n, const Allocator &a = Allocator())
+        : sexp_small_vector_t(a)
+    {
+        resize(n);
+    }
+    sexp_small_vector_t(size_type n, const T &value, const Allocator &a = Allocator())
+        : sexp_small_vector_t(a)
+    {
+        assign(n, value);
+    }
+    template <typename InputIt,
+              typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    sexp_small_vector_t(InputIt b, InputIt e, const Allocator &a = Allocator())
+        : sexp_small_vector_t(a)
+    {
+        assign(b, e);
+    }
+    sexp_small_vector_t(std::initializer_list<T> il, const Allocator &a = Allocator())
+        : sexp_small_vector_t(a)
+    {
+        assign(il.begin(), il.end());
+    }
+    /* the copy has the segment size of other */
+    sexp_small_vector_t(const sexp_small_vector_t &other)
+        : sexp_small_vector_t(
+            alloc_traits::select_on_container_copy_construction(other.get_allocator()))
+    {
+        shift = other.shift;
+        reserve(other.count);
+        assign(other.begin(), other.end());
+    }
+    sexp_small_vector_t(sexp_small_vector_t &&other) noexcept
+        : sexp_small_vector_t(other.get_allocator())
+    {
+        steal(other);
+    }
+    ~sexp_small_vector_t() { release(); }
+
+    sexp_small_vector_t &operator=(const sexp_small_vector_t &other)
+    {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+    sexp_small_vector_t &operator=(sexp_small_vector_t &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value)
+    {
+        if (this != &other)
+            move_assign(other, typename alloc_traits::propagate_on_container_move_assignment());
+        return *this;
+    }
+    sexp_small_vector_t &operator=(std::initializer_list<T> il)
+    {
+        assign(il.begin(), il.end());
+        return *this;
+    }
+
+    void assign(size_type n, const T &value)
+    {
+        T copy(value);
+        clear();
+        reserve(n);
+        while (count < n)
+            push_back(copy);
+    }
+    template <typename InputIt,
+              typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    void assign(InputIt b, InputIt e)
+    {
+        clear();
+        for (; b != e; ++b)
+            emplace_back(*b);
+    }
+    void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
+    allocator_type get_allocator(void) const noexcept { return *this; }
+
+    /* Lets the vector keep elements in segments of n elements once it grows beyond n,
+     * see the class description.  n is rounded up to a power of two above the inline
+     * capacity, 0 (default) keeps the elements contiguous.  The segment size of a
+     * segmented vector is not changed. */
+    void set_segment_size(size_type n) noexcept
+    {
+        if (segmented)
+            return;
+        uint8_t s = 0;
+        if (n > 0) {
+            n = std::min<size_type>(std::max<size_type>(n, N + 1), (size_type) 1 << 30);
+            while (((size_type) 1 << s) < n)
+                s++;
+        }
+        shift = s;
+    }
+    /* Returns the segment size, 0 if segments are not used */
+    size_type segment_size(void) const noexcept { return shift ? (size_type) 1 << shift : 0; }
+    bool      is_segmented(void) const noexcept { return segmented; }
+
+    reference at(size_type pos)
+    {
+        if (pos >= count)
+            throw std::out_of_range("sexp_small_vector_t::at");
+        return *slot(pos);
+    }
+    const_reference at(size_type pos) const
+    {
+        if (pos >= count)
+            throw std::out_of_range("sexp_small_vector_t::at");
+        return *slot(pos);
+    }
+    reference       operator[](size_type pos) noexcept { return *slot(pos); }
+    const_reference operator[](size_type pos) const noexcept { return *slot(pos); }
+    reference       front(void) noexcept { return *slot(0); }
+    const_reference front(void) const noexcept { return *slot(0); }
+    reference       back(void) noexcept { return *slot(count - 1); }
+    const_reference back(void) const noexcept { return *slot(count - 1); }
+    /* Contiguous elements, nullptr if the vector is segmented */
+    T *       data(void) noexcept { return segmented ? nullptr : first; }
+    const T * data(void) const noexcept { return segmented ? nullptr : first; }
+
+    iterator               begin(void) noexcept { return iterator(this, 0); }
+    const_iterator         begin(void) const noexcept { return const_iterator(this, 0); }
+    const_iterator         cbegin(void) const noexcept { return begin(); }
+    iterator               end(void) noexcept { return iterator(this, count); }
+    const_iterator         end(void) const noexcept { return const_iterator(this, count); }
+    const_iterator         cend(void) const noexcept { return end(); }
+    reverse_iterator       rbegin(void) noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin(void) const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin(void) const noexcept { return rbegin(); }
+    reverse_iterator       rend(void) noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend(void) const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend(void) const noexcept { return rend(); }
+
+    /* Changes whenever elements are added, removed, moved or replaced by the modifiers
+     * below.  Lets owners cache data derived from elements.  Assignment through a
+     * reference or an iterator is not seen, use replace() instead. */
+    uint32_t version(void) const noexcept { return changes; }
+
+    bool      empty(void) const noexcept { return count == 0; }
+    size_type size(void) const noexcept { return count; }
+    size_type max_size(void) const noexcept
+    {
+        return std::min<size_type>(alloc_traits::max_size(*this),
+                                   ((size_type) UINT32_MAX >> shift) << shift);
+    }
+    size_type capacity(void) const noexcept { return reserved; }
+    void      reserve(size_type n)
+    {
+        if (n > reserved)
+            expand(n, true);
+    }
+    /* Releases unused heap storage; segments that hold elements are kept */
+    void shrink_to_fit(void)
+    {
+        if (!segmented) {
+            if (!is_inline() && count < reserved)
+                relocate(count);
+            return;
+        }
+        size_type n = reserved >> shift;
+        size_type seg = (size_type) 1 << shift;
+        size_type keep = std::max<size_type>((count + seg - 1) >> shift, 1);
+        if (keep == n)
+            return;
+        if (directory_capacity(keep) < directory_capacity(n))
+            move_directory(n, keep, directory_capacity(keep));
+        else {
+            for (size_type i = keep; i < n; i++)
+                alloc_traits::deallocate(alloc(), directory[i], seg);
+        }
+        reserved = (uint32_t) (keep << shift);
+    }
+
+    void clear(void) noexcept { destroy_all(); }
+
+    template <typename... Args> reference emplace_back(Args &&...args)
+    {
+        if (count == reserved) {
+            /* construct first: args may refer to an element being relocated */
+            T value(std::forward<Args>(args)...);
+            grow(count + 1);
+            alloc_traits::construct(alloc(), slot(count), std::move(value));
+        } else
+            alloc_traits::construct(alloc(), slot(count), std::forward<Args>(args)...);
+        changes++;
+        return *slot(count++);
+    }
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void pop_back(void) noexcept
+    {
+        alloc_traits::destroy(alloc(), slot(--count));
+        changes++;
+    }
+
+    /* Assigns value to the element at pos, pos < size() */
+    void replace(size_type pos, T value)
+    {
+        *slot(pos) = std::move(value);
+        changes++;
+    }
+
+    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
+    {
+        size_type idx = pos - cbegin();
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + idx, end() - 1, end());
+        return begin() + idx;
+    }
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+    iterator insert(const_iterator pos, size_type n, const T &value)
+    {
+        size_type idx = pos - cbegin();
+        size_type old = count;
+        T         copy(value);
+        reserve(count + n);
+        while (count < old + n)
+            emplace_back(copy);
+        std::rotate(begin() + idx, begin() + old, end());
+        return begin() + idx;
+    }
+    template <typename InputIt,
+              typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator pos, InputIt b, InputIt e)
+    {
+        size_type idx = pos - cbegin();
+        size_type old = count;
+        append_range(b, e, typename std::iterator_traits<InputIt>::iterator_category());
+        std::rotate(begin() + idx, begin() + old, end());
+        return begin() + idx;
+    }
+    iterator insert(const_iterator pos, std::initializer_list<T> il)
+    {
+        return insert(pos, il.begin(), il.end());
+    }
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator b, const_iterator e)
+    {
+        iterator dst = begin() + (b - cbegin());
+        if (b != e) {
+            iterator tail = std::move(begin() + (e - cbegin()), end(), dst);
+            while (end() != tail)
+                pop_back();
+        }
+        return dst;
+    }
+
+    void resize(size_type n)
+    {
+        if (n < count) {
+            erase(begin() + n, end());
+            return;
+        }
+        reserve(n);
+        while (count < n)
+            emplace_back();
+    }
+    void resize(size_type n, const T &value)
+    {
+        if (n < count)
+            erase(begin() + n, end());
+        else
+            insert(end(), n - count, value);
+    }
+
+    void swap(sexp_small_vector_t &other)
+    {
+        if (this == &other)
+            return;
+        sexp_small_vector_t tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+};
+
+template <typename T, size_t N, typename A>
+const size_t sexp_small_vector_t<T, N, A>::inline_capacity;
+
+template <typename T, size_t N, typename A>
+bool operator==(const sexp_small_vector_t<T, N, A> &left,
+                const sexp_small_vector_t<T, N, A> &right)
+{
+    return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+}
+
+template <typename T, size_t N, typename A>
+bool operator!=(const sexp_small_vector_t<T, N, A> &left,
+                const sexp_small_vector_t<T, N, A> &right)
+{
+    return !(left == right);
+}
+
+template <typename T, size_t N, typename A>
+void swap(sexp_small_vector_t<T, N, A> &left, sexp_small_vector_t<T, N, A> &right)
+{
+    left.swap(right);
+}
+
+} // namespace sexp
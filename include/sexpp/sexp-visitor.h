@@ -0,0 +1,85 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP visitor
+ * Walks a tree in document order and calls the member functions of Derived:
+ *     visit_string(str)  for every string
+ *     enter_list(list)   for every list, before its elements
+ *     leave_list(list)   for every list, after its elements
+ *     visit_other(obj)   for objects of other classes
+ * Derived overrides the functions it needs (they are found at compile time, not
+ * virtual).  Each returns proceed to go on, skip from enter_list to pass over the
+ * elements of the list (leave_list is still called), or stop to end the walk.
+ *
+ * Nodes are dispatched by their kind tag, so there are no virtual calls per node;
+ * objects derived from sexp_string_t or sexp_list_t are visited as strings or lists.
+ * The library's own printers check the dynamic type of such objects and call their
+ * virtual functions, so overrides are kept.
+ */
+
+template <typename Derived> class sexp_visitor_t {
+  public:
+    enum action_t { proceed, skip, stop };
+
+    action_t visit_string(const sexp_string_t &) { return proceed; }
+    action_t enter_list(const sexp_list_t &) { return proceed; }
+    action_t leave_list(const sexp_list_t &) { return proceed; }
+    action_t visit_other(const sexp_object_t &) { return proceed; }
+
+    /* Walks the tree rooted at obj, returns false if the walk was stopped */
+    bool traverse(const sexp_object_t &obj) { return walk(obj) != stop; }
+
+  private:
+    action_t walk(const sexp_object_t &obj)
+    {
+        Derived &self = static_cast<Derived &>(*this);
+        switch (obj.get_kind()) {
+        case sexp_object_t::string_kind:
+            return self.visit_string(static_cast<const sexp_string_t &>(obj)) == stop ? stop :
+                                                                                        proceed;
+        case sexp_object_t::list_kind: {
+            const sexp_list_t &list = static_cast<const sexp_list_t &>(obj);
+            action_t           action = self.enter_list(list);
+            if (action == stop)
+                return stop;
+            if (action != skip) {
+                for (const auto &child : list)
+                    if (walk(*child) == stop)
+                        return stop;
+            }
+            return self.leave_list(list) == stop ? stop : proceed;
+        }
+        default:
+            return self.visit_other(obj) == stop ? stop : proceed;
+        }
+    }
+};
+
+} // namespace sexp
@@ -0,0 +1,84 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include "sexp-public.h"
+#include "sexp.h"
+
+namespace sexp {
+
+/*
+ * SEXP writer
+ * Emits S-expressions to an output stream element by element, without building
+ * sexp_list_t/sexp_string_t objects.  Canonical and base64 images are the same as
+ * print_canonical and print_base64 of the equivalent tree produce.  In advanced mode
+ * list lengths are not known in advance, so lists are never broken into lines: the
+ * writer sets max column of the stream to 0 until it is destroyed and the image is the
+ * same as print_advanced produces with no line width limit.
+ * List nesting is checked by the output stream.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_writer_t {
+  protected:
+    sexp_output_stream_t *                output;
+    sexp_output_stream_t::sexp_print_mode mode;
+    size_t                                depth;            /* number of open lists */
+    bool                                  need_space;       /* advanced mode separator */
+    uint32_t                              saved_max_column; /* restored by the destructor */
+
+    void begin_element(void);
+    void end_element(void);
+    void put_verbatim(const octet_t *bt, size_t ln);
+    void put_advanced(const octet_t *bt, size_t ln);
+    void put_simple_string(const octet_t *bt, size_t ln);
+
+  public:
+    sexp_writer_t(sexp_output_stream_t *                o,
+                  sexp_output_stream_t::sexp_print_mode m = sexp_output_stream_t::canonical);
+    ~sexp_writer_t();
+
+    sexp_writer_t *begin_list(void);
+    sexp_writer_t *end_list(void);
+    sexp_writer_t *atom(const octet_t *bt, size_t ln);
+    sexp_writer_t *atom(const char *str)
+    {
+        return atom(reinterpret_cast<const octet_t *>(str), std::strlen(str));
+    }
+    sexp_writer_t *atom(const sexp_simple_string_t &ss) { return atom(ss.data(), ss.length()); }
+    sexp_writer_t *atom_with_hint(const octet_t *hint,
+                                  size_t         hint_ln,
+                                  const octet_t *bt,
+                                  size_t         ln);
+    sexp_writer_t *atom_with_hint(const char *hint, const char *str)
+    {
+        return atom_with_hint(reinterpret_cast<const octet_t *>(hint),
+                              std::strlen(hint),
+                              reinterpret_cast<const octet_t *>(str),
+                              std::strlen(str));
+    }
+
+    size_t get_depth(void) const noexcept { return depth; }
+};
+
+} // namespace sexp
@@ -34,6 +34,7 @@
 
 #include <cinttypes>
 #include <climits>
+#include <atomic>
 #include <limits>
 #include <cctype>
 #include <locale>
@@ -44,9 +45,13 @@
 #include <string>
 #include <vector>
 #include <cassert>
+#ifdef SEXP_WITH_PMR
+#include <memory_resource>
+#endif
 
 #include "sexp-public.h"
 #include "sexp-error.h"
+#include "sexp-small-vector.h"
 
 // We are implementing char traits for octet_t with the following restrictions
 //  -- limit visibility so that other traits for unsigned char are still possible
@@ -178,29 +183,251 @@ class SEXP_PUBLIC_SYMBOL sexp_char_defs_t {
     };
 };
 
+/*
+ * sexp_cache_t
+ * Value derived from the contents of an object and cached in it on first use.
+ * It is updated from const methods, so access is atomic (relaxed) to keep concurrent
+ * readers of a shared object race free.  Copies of an object carry the cached value.
+ */
+template <typename T> class sexp_cache_t {
+  private:
+    std::atomic<T> value;
+
+  public:
+    sexp_cache_t(T v = T()) noexcept : value(v) {}
+    sexp_cache_t(const sexp_cache_t &c) noexcept : value(c.get()) {}
+    sexp_cache_t &operator=(const sexp_cache_t &c) noexcept
+    {
+        set(c.get());
+        return *this;
+    }
+    T get(std::memory_order order = std::memory_order_relaxed) const noexcept
+    {
+        return value.load(order);
+    }
+    void set(T v, std::memory_order order = std::memory_order_relaxed) noexcept
+    {
+        value.store(v, order);
+    }
+};
+
 class sexp_string_t;
 class sexp_list_t;
 
 class sexp_output_stream_t;
 class sexp_input_stream_t;
+class sexp_intern_table_t;
+class sexp_hashcons_table_t;
 
 /*
  * SEXP simple string
  */
 
+/*
+ * Allocator of strings, lists and nodes.  With SEXP_WITH_PMR (C++17, see WITH_PMR
+ * build option) it is polymorphic, and objects scanned by an input stream draw
+ * their memory from the stream's std::pmr::memory_resource.
+ */
+#ifdef SEXP_WITH_PMR
+using sexp_allocator_t = std::pmr::polymorphic_allocator<octet_t>;
+#else
+using sexp_allocator_t = std::allocator<octet_t>;
+#endif
+
 using octet_traits = std::char_traits<octet_t>;
-using octet_string = std::basic_string<octet_t, octet_traits>;
+using octet_string = std::basic_string<octet_t, octet_traits, sexp_allocator_t>;
 
+/*
+ * Modifiers of octet_string are shadowed by members that drop the cached character
+ * classes and hash.  Code that modifies the contents through a reference to the
+ * octet_string base shall call invalidate() afterwards.
+ */
 class SEXP_PUBLIC_SYMBOL sexp_simple_string_t : public octet_string, private sexp_char_defs_t {
+  private:
+    /* Character classes of the contents, computed once by classify() */
+    enum {
+        classified = 0x01,    /* the flags below are valid */
+        token_safe = 0x02,    /* can be printed as a token */
+        quote_safe = 0x04,    /* can be printed as a quoted string without escapes */
+        leading_digit = 0x08, /* starts with a decimal digit */
+    };
+    mutable sexp_cache_t<uint8_t>  classification;
+    mutable sexp_cache_t<uint64_t> hash_value; /* 0 if not computed yet */
+
+    static uint8_t classify(const octet_t *bt, size_t ln);
+    uint8_t        classify(void) const;
+
   public:
     sexp_simple_string_t(void) = default;
+    explicit sexp_simple_string_t(const sexp_allocator_t &a) : octet_string(a) {}
+    sexp_simple_string_t(const sexp_simple_string_t &ss) = default;
+    sexp_simple_string_t(sexp_simple_string_t &&ss) noexcept
+        : octet_string(std::move(ss)), classification(ss.classification),
+          hash_value(ss.hash_value)
+    {
+        ss.clear();
+    }
+    sexp_simple_string_t(sexp_simple_string_t &&ss, const sexp_allocator_t &a)
+        : octet_string(std::move(ss), a), classification(ss.classification),
+          hash_value(ss.hash_value)
+    {
+        ss.clear();
+    }
+    sexp_simple_string_t(const sexp_simple_string_t &ss, const sexp_allocator_t &a)
+        : octet_string(ss, a), classification(ss.classification), hash_value(ss.hash_value)
+    {
+    }
     sexp_simple_string_t(const octet_t *dt) : octet_string{dt} {}
     sexp_simple_string_t(const octet_t *bt, size_t ln) : octet_string{bt, ln} {}
+
+    sexp_simple_string_t &operator=(const sexp_simple_string_t &ss) = default;
+    sexp_simple_string_t &operator=(sexp_simple_string_t &&ss)
+    {
+        if (this != &ss) {
+            octet_string::operator=(std::move(ss));
+            classification = ss.classification;
+            hash_value = ss.hash_value;
+            ss.clear();
+        }
+        return *this;
+    }
+
+    // Drops cached character classes and hash; shall be called after the contents are
+    // modified through octet_string interface
+    void invalidate(void) noexcept
+    {
+        classification.set(0);
+        hash_value.set(0);
+    }
+
+    /* Element access; non-const overloads drop the caches, as the contents may change
+     * through the returned reference or iterator */
+    const_reference operator[](size_type pos) const { return octet_string::operator[](pos); }
+    reference       operator[](size_type pos)
+    {
+        invalidate();
+        return octet_string::operator[](pos);
+    }
+    const_reference at(size_type pos) const { return octet_string::at(pos); }
+    reference       at(size_type pos)
+    {
+        invalidate();
+        return octet_string::at(pos);
+    }
+    const_reference front(void) const { return octet_string::front(); }
+    reference       front(void)
+    {
+        invalidate();
+        return octet_string::front();
+    }
+    const_reference back(void) const { return octet_string::back(); }
+    reference       back(void)
+    {
+        invalidate();
+        return octet_string::back();
+    }
+    const_iterator begin(void) const noexcept { return octet_string::begin(); }
+    iterator       begin(void) noexcept
+    {
+        invalidate();
+        return octet_string::begin();
+    }
+    const_iterator end(void) const noexcept { return octet_string::end(); }
+    iterator       end(void) noexcept
+    {
+        invalidate();
+        return octet_string::end();
+    }
+    const_reverse_iterator rbegin(void) const noexcept { return octet_string::rbegin(); }
+    reverse_iterator       rbegin(void) noexcept
+    {
+        invalidate();
+        return octet_string::rbegin();
+    }
+    const_reverse_iterator rend(void) const noexcept { return octet_string::rend(); }
+    reverse_iterator       rend(void) noexcept
+    {
+        invalidate();
+        return octet_string::rend();
+    }
+
+    /* Modifiers */
     sexp_simple_string_t &append(int c)
     {
-        (*this) += (octet_t)(c & 0xFF);
+        push_back(c);
         return *this;
     }
+    sexp_simple_string_t &append(const octet_t *bt, size_t ln)
+    {
+        octet_string::append(bt, ln);
+        invalidate();
+        return *this;
+    }
+    template <typename T> sexp_simple_string_t &operator+=(const T &t)
+    {
+        octet_string::operator+=(t);
+        invalidate();
+        return *this;
+    }
+    template <typename... Args> sexp_simple_string_t &assign(Args &&... args)
+    {
+        octet_string::assign(std::forward<Args>(args)...);
+        invalidate();
+        return *this;
+    }
+    template <typename... Args>
+    auto insert(Args &&... args) -> decltype(octet_string::insert(std::forward<Args>(args)...))
+    {
+        invalidate();
+        return octet_string::insert(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto erase(Args &&... args) -> decltype(octet_string::erase(std::forward<Args>(args)...))
+    {
+        invalidate();
+        return octet_string::erase(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto replace(Args &&... args) -> decltype(octet_string::replace(std::forward<Args>(args)...))
+    {
+        invalidate();
+        return octet_string::replace(std::forward<Args>(args)...);
+    }
+    void push_back(int c)
+    {
+        octet_string::push_back((octet_t)(c & 0xFF));
+        invalidate();
+    }
+    void pop_back(void)
+    {
+        octet_string::pop_back();
+        invalidate();
+    }
+    void clear(void) noexcept
+    {
+        octet_string::clear();
+        invalidate();
+    }
+    void resize(size_type n, octet_t c = 0)
+    {
+        octet_string::resize(n, c);
+        invalidate();
+    }
+    /* Sets the octet at pos, pos < length() */
+    void set(size_type pos, octet_t c)
+    {
+        octet_string::operator[](pos) = c;
+        invalidate();
+    }
+    void swap(sexp_simple_string_t &ss)
+    {
+        octet_string::swap(ss);
+        invalidate();
+        ss.invalidate();
+    }
+
+    // Returns hash of the contents, computed once and cached
+    uint64_t hash(void) const;
     // Returns length for printing simple string as a token
     size_t advanced_length_token(void) const { return length(); }
     // Returns length for printing simple string as a base64 string
@@ -219,7 +446,11 @@ class SEXP_PUBLIC_SYMBOL sexp_simple_string_t : public octet_string, private sex
     sexp_output_stream_t *print_base64(sexp_output_stream_t *os) const;
 
     bool can_print_as_quoted_string(void) const;
+    bool can_print_as_token(void) const;
     bool can_print_as_token(const sexp_output_stream_t *os) const;
+    /* Same checks for octets that are not held in a simple string */
+    static bool can_print_as_quoted_string(const octet_t *bt, size_t ln);
+    static bool can_print_as_token(const octet_t *bt, size_t ln);
 
     bool operator==(const char *right) const noexcept
     {
@@ -236,6 +467,34 @@ class SEXP_PUBLIC_SYMBOL sexp_simple_string_t : public octet_string, private sex
         return empty() ? std::numeric_limits<uint32_t>::max() :
                          (unsigned) atoi(reinterpret_cast<const char *>(c_str()));
     }
+
+    /* Bytes of the contents */
+    struct span_t {
+        const octet_t *data;
+        size_t         length;
+    };
+
+    // Returns the contents as a big-endian unsigned magnitude with leading zero octets
+    // skipped; points into the string, the magnitude of zero is empty
+    span_t magnitude(void) const noexcept
+    {
+        const octet_t *bt = data();
+        size_t         ln = length();
+        while (ln && !*bt) {
+            bt++;
+            ln--;
+        }
+        return {bt, ln};
+    }
+    // Returns the number of 64-bit limbs the magnitude takes
+    size_t limb_count(void) const noexcept { return (magnitude().length + 7) / 8; }
+    // Stores the magnitude into count little-endian 64-bit limbs, least significant
+    // first, and zeroes the limbs above it.  Returns limb_count(); if it exceeds count,
+    // nothing is stored.
+    size_t to_limbs(uint64_t *limbs, size_t count) const noexcept;
+    // Parses the contents as a decimal number; returns false, leaving value intact, if
+    // they are not all digits or the number does not fit
+    bool to_uint64(uint64_t &value) const noexcept;
 };
 
 inline bool operator==(const sexp_simple_string_t *left, const std::string &right) noexcept
@@ -253,9 +512,42 @@ inline bool operator!=(const sexp_simple_string_t *left, const std::string &righ
  */
 
 class SEXP_PUBLIC_SYMBOL sexp_object_t {
+  public:
+    /* Kind of the node, lets traversals dispatch without virtual calls */
+    enum kind_t : uint8_t { other_kind = 0, string_kind = 1, list_kind = 2 };
+
+  protected:
+    kind_t object_kind;
+    bool   shared; /* see set_shared() */
+
+    explicit sexp_object_t(kind_t kind = other_kind) noexcept
+        : object_kind(kind), shared(false)
+    {
+    }
+    /* a copy is private to its owner */
+    sexp_object_t(const sexp_object_t &obj) noexcept
+        : object_kind(obj.object_kind), shared(false)
+    {
+    }
+    sexp_object_t &operator=(const sexp_object_t &) noexcept { return *this; }
+
+    void check_unshared(void) const
+    {
+        if (shared)
+            sexp_error(sexp_exception_t::error, "Shared object cannot be modified", 0, 0, EOF);
+    }
+
   public:
     virtual ~sexp_object_t(){};
 
+    kind_t get_kind(void) const noexcept { return object_kind; }
+
+    /* Marks the object as shared between trees, e.g. by an intern table.  Modifiers of a
+     * shared object raise an error; sexp_list_t::unshare() replaces an element that is
+     * shared by a private copy. */
+    void set_shared(void) noexcept { shared = true; }
+    bool is_shared(void) const noexcept { return shared; }
+
     virtual sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const = 0;
     virtual sexp_output_stream_t *print_advanced(sexp_output_stream_t *os) const;
     virtual size_t                advanced_length(sexp_output_stream_t *os) const = 0;
@@ -292,40 +584,193 @@ class SEXP_PUBLIC_SYMBOL sexp_object_t {
  * SEXP string
  */
 
+/*
+ * Presentation hint of a string.  Few strings have a hint, so it is allocated only
+ * when it is set, with the allocator of the string; strings without a hint pay for
+ * a null pointer only.
+ */
+class SEXP_PUBLIC_SYMBOL sexp_presentation_hint_t {
+  private:
+    typedef std::allocator_traits<sexp_allocator_t>::rebind_alloc<sexp_simple_string_t>
+                                               allocator_t;
+    typedef std::allocator_traits<allocator_t> alloc_traits;
+
+    sexp_simple_string_t *hint;
+
+    /* Allocates a simple string with allocator a and constructs it from args */
+    template <typename... Args>
+    static sexp_simple_string_t *create(const sexp_allocator_t &a, Args &&...args)
+    {
+        allocator_t           alloc(a);
+        sexp_simple_string_t *p = alloc_traits::allocate(alloc, 1);
+        try {
+            ::new (static_cast<void *>(p)) sexp_simple_string_t(std::forward<Args>(args)...);
+        } catch (...) {
+            alloc_traits::deallocate(alloc, p, 1);
+            throw;
+        }
+        return p;
+    }
+    /* Returned for strings without a hint */
+    static const sexp_simple_string_t &none(void) noexcept;
+    /* Allocator for a copy of hint h; the block and the string in it always share one
+     * allocator, which reset() frees the block with */
+    static sexp_allocator_t copy_allocator(const sexp_simple_string_t &h)
+    {
+        return std::allocator_traits<sexp_allocator_t>::select_on_container_copy_construction(
+          h.get_allocator());
+    }
+
+  public:
+    sexp_presentation_hint_t(void) noexcept : hint(nullptr) {}
+    explicit sexp_presentation_hint_t(sexp_simple_string_t &&ph)
+        : hint(create(ph.get_allocator(), std::move(ph)))
+    {
+    }
+    sexp_presentation_hint_t(sexp_simple_string_t &&ph, const sexp_allocator_t &a)
+        : hint(create(a, std::move(ph), a))
+    {
+    }
+    sexp_presentation_hint_t(const sexp_presentation_hint_t &h) : hint(nullptr)
+    {
+        if (h.hint != nullptr) {
+            sexp_allocator_t a = copy_allocator(*h.hint);
+            hint = create(a, *h.hint, a);
+        }
+    }
+    sexp_presentation_hint_t(sexp_presentation_hint_t &&h) noexcept : hint(h.hint)
+    {
+        h.hint = nullptr;
+    }
+    sexp_presentation_hint_t(sexp_presentation_hint_t &&h, const sexp_allocator_t &a)
+        : hint(nullptr)
+    {
+        if (h.hint == nullptr)
+            return;
+        if (h.hint->get_allocator() == a)
+            std::swap(hint, h.hint);
+        else
+            hint = create(a, std::move(*h.hint), a);
+    }
+    ~sexp_presentation_hint_t() { reset(); }
+
+    sexp_presentation_hint_t &operator=(const sexp_presentation_hint_t &h)
+    {
+        if (h.hint == nullptr)
+            reset();
+        else if (this != &h)
+            emplace(copy_allocator(*h.hint)) = *h.hint;
+        return *this;
+    }
+    sexp_presentation_hint_t &operator=(sexp_presentation_hint_t &&h) noexcept
+    {
+        std::swap(hint, h.hint);
+        h.reset();
+        return *this;
+    }
+
+    bool                        has_value(void) const noexcept { return hint != nullptr; }
+    const sexp_simple_string_t &get(void) const noexcept
+    {
+        return hint != nullptr ? *hint : none();
+    }
+    /* Returns the hint, creating an empty one with allocator a if there is none */
+    sexp_simple_string_t &emplace(const sexp_allocator_t &a)
+    {
+        if (hint == nullptr)
+            hint = create(a, a);
+        return *hint;
+    }
+    void reset(void) noexcept
+    {
+        if (hint == nullptr)
+            return;
+        allocator_t alloc(hint->get_allocator());
+        hint->~sexp_simple_string_t();
+        alloc_traits::deallocate(alloc, hint, 1);
+        hint = nullptr;
+    }
+};
+
 class SEXP_PUBLIC_SYMBOL sexp_string_t : public sexp_object_t {
   protected:
-    bool                 with_presentation_hint;
-    sexp_simple_string_t presentation_hint;
-    sexp_simple_string_t data_string;
+    sexp_presentation_hint_t presentation_hint;
+    sexp_simple_string_t     data_string;
 
   public:
-    sexp_string_t(const octet_t *dt) : with_presentation_hint(false), data_string(dt) {}
+    typedef sexp_allocator_t allocator_type;
+
+    sexp_string_t(const octet_t *dt) : sexp_object_t(string_kind), data_string(dt) {}
     sexp_string_t(const octet_t *bt, size_t ln)
-        : with_presentation_hint(false), data_string(bt, ln)
+        : sexp_object_t(string_kind), data_string(bt, ln)
     {
     }
     sexp_string_t(const std::string &str)
-        : with_presentation_hint(false),
+        : sexp_object_t(string_kind),
           data_string(reinterpret_cast<const octet_t *>(str.data()))
     {
     }
-    sexp_string_t(void) : with_presentation_hint(false) {}
-    sexp_string_t(sexp_input_stream_t *sis) { parse(sis); };
+    /* These take over the buffers of the simple strings */
+    explicit sexp_string_t(sexp_simple_string_t &&ss)
+        : sexp_object_t(string_kind), data_string(std::move(ss))
+    {
+    }
+    sexp_string_t(sexp_simple_string_t &&ph, sexp_simple_string_t &&ss)
+        : sexp_object_t(string_kind), presentation_hint(std::move(ph)),
+          data_string(std::move(ss))
+    {
+    }
+    sexp_string_t(void) : sexp_object_t(string_kind) {}
+    explicit sexp_string_t(const sexp_allocator_t &a)
+        : sexp_object_t(string_kind), data_string(a)
+    {
+    }
+    sexp_string_t(sexp_string_t &&s, const sexp_allocator_t &a)
+        : sexp_object_t(string_kind), presentation_hint(std::move(s.presentation_hint), a),
+          data_string(std::move(s.data_string), a)
+    {
+    }
+    sexp_string_t(sexp_simple_string_t &&ss, const sexp_allocator_t &a)
+        : sexp_object_t(string_kind), data_string(std::move(ss), a)
+    {
+    }
+    sexp_string_t(sexp_simple_string_t && ph,
+                  sexp_simple_string_t && ss,
+                  const sexp_allocator_t &a)
+        : sexp_object_t(string_kind), presentation_hint(std::move(ph), a),
+          data_string(std::move(ss), a)
+    {
+    }
+    sexp_string_t(sexp_input_stream_t *sis) : sexp_object_t(string_kind) { parse(sis); };
 
-    const bool has_presentation_hint(void) const noexcept { return with_presentation_hint; }
+    const bool has_presentation_hint(void) const noexcept
+    {
+        return presentation_hint.has_value();
+    }
     const sexp_simple_string_t &get_string(void) const noexcept { return data_string; }
     const sexp_simple_string_t &set_string(const sexp_simple_string_t &ss)
     {
+        check_unshared();
         return data_string = ss;
     }
+    const sexp_simple_string_t &set_string(sexp_simple_string_t &&ss)
+    {
+        check_unshared();
+        return data_string = std::move(ss);
+    }
     const sexp_simple_string_t &get_presentation_hint(void) const noexcept
     {
-        return presentation_hint;
+        return presentation_hint.get();
     }
     const sexp_simple_string_t &set_presentation_hint(const sexp_simple_string_t &ph)
     {
-        with_presentation_hint = true;
-        return presentation_hint = ph;
+        check_unshared();
+        return presentation_hint.emplace(data_string.get_allocator()) = ph;
+    }
+    const sexp_simple_string_t &set_presentation_hint(sexp_simple_string_t &&ph)
+    {
+        check_unshared();
+        return presentation_hint.emplace(data_string.get_allocator()) = std::move(ph);
     }
 
     virtual sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const;
@@ -340,6 +785,8 @@ class SEXP_PUBLIC_SYMBOL sexp_string_t : public sexp_object_t {
 
     void             parse(sexp_input_stream_t *sis);
     virtual unsigned as_unsigned() const noexcept { return data_string.as_unsigned(); }
+    /* Structural hash, see sexp_hash() */
+    uint64_t hash(void) const;
 };
 
 inline bool operator==(const sexp_string_t *left, const std::string &right) noexcept
@@ -356,11 +803,149 @@ inline bool operator!=(const sexp_string_t *left, const std::string &right) noex
  * SEXP list
  */
 
-class SEXP_PUBLIC_SYMBOL sexp_list_t : public sexp_object_t,
-                                       public std::vector<std::shared_ptr<sexp_object_t>> {
+/*
+ * Children of a list.  Most lists in keys and signatures have two to four elements,
+ * these are kept inside the list object without a separate allocation.  Very wide
+ * lists may keep them in segments, see sexp_input_stream_t::set_list_segment_size().
+ * A shared list does not see assignment to its elements through references, nor
+ * modification of its elements in place; shared lists built by a hash-consing table
+ * only hold shared elements.
+ */
+
+typedef sexp_small_vector_t<
+  std::shared_ptr<sexp_object_t>,
+  4,
+  std::allocator_traits<sexp_allocator_t>::rebind_alloc<std::shared_ptr<sexp_object_t>>>
+  sexp_list_children_t;
+
+class SEXP_PUBLIC_SYMBOL sexp_list_t : public sexp_object_t, public sexp_list_children_t {
+  private:
+    /* Positions of child lists by their leading token, see find_token() */
+    struct token_index_t;
+    class token_index_ptr_t {
+        std::atomic<token_index_t *> ptr;
+
+      public:
+        token_index_ptr_t(void) noexcept : ptr(nullptr) {}
+        /* a copied list builds its own index */
+        token_index_ptr_t(const token_index_ptr_t &) noexcept : ptr(nullptr) {}
+        token_index_ptr_t &operator=(const token_index_ptr_t &)
+        {
+            reset(nullptr);
+            return *this;
+        }
+        ~token_index_ptr_t() { reset(nullptr); }
+
+        token_index_t *get(void) const noexcept { return ptr.load(std::memory_order_acquire); }
+        token_index_t *install(token_index_t *expected, token_index_t *index) noexcept;
+        void           reset(token_index_t *index) noexcept;
+    };
+    mutable token_index_ptr_t token_index;
+
+    /* Hash of a shared list, which is not modified; a copied list computes its own */
+    struct hash_cache_t : sexp_cache_t<uint64_t> {
+        hash_cache_t(void) = default;
+        hash_cache_t(const hash_cache_t &) noexcept {}
+        hash_cache_t &operator=(const hash_cache_t &) noexcept
+        {
+            set(0);
+            return *this;
+        }
+    };
+    mutable hash_cache_t shared_hash;
+
+    const token_index_t *get_token_index(void) const;
+
   public:
+    /* Lists with at least that many children are searched by find_token() through an
+     * index */
+    static const size_type TOKEN_INDEX_THRESHOLD = 8;
+
+    sexp_list_t(void) : sexp_object_t(list_kind) {}
+    explicit sexp_list_t(const sexp_allocator_t &a)
+        : sexp_object_t(list_kind), sexp_list_children_t(a)
+    {
+    }
     virtual ~sexp_list_t() {}
 
+    /* Modifiers of the children raise an error if the list is shared, see
+     * sexp_object_t::set_shared() */
+    template <typename... Args> void push_back(Args &&...args)
+    {
+        check_unshared();
+        sexp_list_children_t::push_back(std::forward<Args>(args)...);
+    }
+    template <typename... Args> reference emplace_back(Args &&...args)
+    {
+        check_unshared();
+        return sexp_list_children_t::emplace_back(std::forward<Args>(args)...);
+    }
+    template <typename... Args> iterator emplace(const_iterator pos, Args &&...args)
+    {
+        check_unshared();
+        return sexp_list_children_t::emplace(pos, std::forward<Args>(args)...);
+    }
+    template <typename... Args> iterator insert(Args &&...args)
+    {
+        check_unshared();
+        return sexp_list_children_t::insert(std::forward<Args>(args)...);
+    }
+    iterator insert(const_iterator pos, std::initializer_list<value_type> il)
+    {
+        check_unshared();
+        return sexp_list_children_t::insert(pos, il);
+    }
+    template <typename... Args> iterator erase(Args &&...args)
+    {
+        check_unshared();
+        return sexp_list_children_t::erase(std::forward<Args>(args)...);
+    }
+    template <typename... Args> void assign(Args &&...args)
+    {
+        check_unshared();
+        sexp_list_children_t::assign(std::forward<Args>(args)...);
+    }
+    void assign(std::initializer_list<value_type> il)
+    {
+        check_unshared();
+        sexp_list_children_t::assign(il.begin(), il.end());
+    }
+    template <typename... Args> void resize(Args &&...args)
+    {
+        check_unshared();
+        sexp_list_children_t::resize(std::forward<Args>(args)...);
+    }
+    void replace(size_type pos, std::shared_ptr<sexp_object_t> value)
+    {
+        check_unshared();
+        sexp_list_children_t::replace(pos, std::move(value));
+    }
+    void pop_back(void)
+    {
+        check_unshared();
+        sexp_list_children_t::pop_back();
+    }
+    void clear(void)
+    {
+        check_unshared();
+        sexp_list_children_t::clear();
+    }
+    void swap(sexp_list_t &other)
+    {
+        check_unshared();
+        other.check_unshared();
+        sexp_list_children_t::swap(other);
+    }
+
+    /* Creates an element of type T from args with the allocator of the list and
+     * appends it, e.g. emplace_object<sexp_string_t>(std::move(ss)) */
+    template <typename T, typename... Args> std::shared_ptr<T> emplace_object(Args &&...args)
+    {
+        auto obj = std::allocate_shared<T>(get_allocator(), std::forward<Args>(args)...);
+        push_back(obj);
+        return obj;
+    }
+
     virtual sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const;
     virtual sexp_output_stream_t *print_advanced(sexp_output_stream_t *os) const;
     virtual size_t                advanced_length(sexp_output_stream_t *os) const;
@@ -382,9 +967,90 @@ class SEXP_PUBLIC_SYMBOL sexp_list_t : public sexp_object_t,
         return s != nullptr ? &s->get_string() : nullptr;
     }
 
+    /* Returns the first child list that starts with the string name (presentation hints
+     * are not compared), nullptr if there is none */
+    const sexp_list_t *find_token(const octet_t *name, size_t length) const;
+    const sexp_list_t *find_token(const char *name) const
+    {
+        return find_token(reinterpret_cast<const octet_t *>(name), std::strlen(name));
+    }
+    const sexp_list_t *find_token(const std::string &name) const
+    {
+        return find_token(reinterpret_cast<const octet_t *>(name.data()), name.length());
+    }
+
+    /* Structural hash, see sexp_hash() */
+    uint64_t hash(void) const;
+
+    /* Copy-on-write: replaces the element at pos by a private copy if it is shared, see
+     * sexp_object_t::set_shared(), and returns the element */
+    const std::shared_ptr<sexp_object_t> &unshare(size_type pos);
+
     void parse(sexp_input_stream_t *sis);
 };
 
+/*
+ * Structural comparison and hashing
+ * Two objects are equal if their canonical images are equal.  Strings order before
+ * lists, strings are ordered by contents and then by presentation hint (strings
+ * without hint first), lists lexicographically by elements.
+ * Hashes of strings are cached in the strings and dropped when they are modified.
+ * Hashes of lists are folded from the hashes of their elements on each call, so they
+ * follow in-place modification of any descendant, except for shared lists, which
+ * cache their hash, see sexp_object_t::set_shared().
+ */
+
+SEXP_PUBLIC_SYMBOL bool     sexp_equal(const sexp_object_t &left, const sexp_object_t &right);
+SEXP_PUBLIC_SYMBOL int      sexp_compare(const sexp_object_t &left, const sexp_object_t &right);
+SEXP_PUBLIC_SYMBOL uint64_t sexp_hash(const sexp_object_t &obj);
+
+inline bool operator==(const sexp_object_t &left, const sexp_object_t &right)
+{
+    return sexp_equal(left, right);
+}
+
+inline bool operator!=(const sexp_object_t &left, const sexp_object_t &right)
+{
+    return !sexp_equal(left, right);
+}
+
+inline bool operator<(const sexp_object_t &left, const sexp_object_t &right)
+{
+    return sexp_compare(left, right) < 0;
+}
+
+/* Lists are also containers, these select the structural comparison */
+inline bool operator==(const sexp_list_t &left, const sexp_list_t &right)
+{
+    return sexp_equal(left, right);
+}
+
+inline bool operator!=(const sexp_list_t &left, const sexp_list_t &right)
+{
+    return !sexp_equal(left, right);
+}
+
+/* Function objects for unordered containers keyed by objects or pointers to them */
+struct sexp_object_hash_t {
+    size_t operator()(const sexp_object_t &obj) const { return (size_t) sexp_hash(obj); }
+    size_t operator()(const std::shared_ptr<sexp_object_t> &obj) const
+    {
+        return (size_t) sexp_hash(*obj);
+    }
+};
+
+struct sexp_object_equal_t {
+    bool operator()(const sexp_object_t &left, const sexp_object_t &right) const
+    {
+        return sexp_equal(left, right);
+    }
+    bool operator()(const std::shared_ptr<sexp_object_t> &left,
+                    const std::shared_ptr<sexp_object_t> &right) const
+    {
+        return sexp_equal(*left, *right);
+    }
+};
+
 /*
     sexp_depth_manager controls maximum allowed nesting of sexp lists
     for sexp_input_stream, sexp_output_stream processing
@@ -399,10 +1065,119 @@ class SEXP_PUBLIC_SYMBOL sexp_depth_manager {
     size_t depth;     /* current depth of nested SEXP lists */
     size_t max_depth; /* maximum allowed depth of nested SEXP lists, 0 if no limit */
   protected:
+    /* restores the depth on scope exit, also when an exception escapes */
+    class depth_guard_t {
+        sexp_depth_manager &manager;
+        size_t              saved;
+
+      public:
+        depth_guard_t(sexp_depth_manager &m) : manager(m), saved(m.depth) {}
+        depth_guard_t(const depth_guard_t &) = delete;
+        depth_guard_t &operator=(const depth_guard_t &) = delete;
+        ~depth_guard_t() { manager.depth = saved; }
+    };
+
     sexp_depth_manager(size_t m_depth = DEFAULT_MAX_DEPTH);
-    void reset_depth(size_t m_depth);
-    void increase_depth(int count = -1);
-    void decrease_depth(void);
+    void   reset_depth(size_t m_depth);
+    void   increase_depth(int count = -1);
+    void   decrease_depth(void);
+    size_t get_depth(void) const noexcept { return depth; }
+    size_t get_max_depth(void) const noexcept { return max_depth; }
+};
+
+/*
+ * SEXP byte source
+ * Input stream reads bytes through this interface.  A source exposes a window of
+ * bytes [next, last) that are consumed without virtual calls; fill() is called to
+ * get more when the window is exhausted.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_byte_source_t {
+  protected:
+    const octet_t *next; /* next byte to be read */
+    const octet_t *last; /* end of bytes available without calling fill() */
+
+    /* Makes more bytes available in [next, last), returns false at the end of input */
+    virtual bool fill(void) = 0;
+
+  public:
+    sexp_byte_source_t(void) : next(nullptr), last(nullptr) {}
+    virtual ~sexp_byte_source_t() = default;
+
+    /* Returns the bytes available without calling fill(); they are not read, the
+     * parser looks at them to size strings before scanning */
+    const octet_t *buffered(size_t &ln) const noexcept
+    {
+        ln = last - next;
+        return next;
+    }
+
+    /* Reads and returns the next byte, EOF at the end of input */
+    int get(void) { return (next < last || fill()) ? *next++ : EOF; }
+    /* Returns the next byte without reading it, EOF at the end of input */
+    int peek(void) { return (next < last || fill()) ? *next : EOF; }
+    /* Reads up to ln bytes into bt, returns number of bytes read */
+    size_t read(octet_t *bt, size_t ln);
+};
+
+/*
+ * SEXP byte sink
+ * Output stream writes bytes through this interface.  Buffering sinks deliver
+ * bytes on flush() (and on destruction).
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_byte_sink_t {
+  public:
+    virtual ~sexp_byte_sink_t() = default;
+
+    virtual void put(octet_t c) = 0;
+    virtual void write(const octet_t *bt, size_t ln);
+    virtual void flush(void) {}
+};
+
+/*
+ * Adapters for standard streams.  Bytes are passed one by one, so nothing is read
+ * ahead or held back in the adapters.
+ */
+
+class SEXP_PUBLIC_SYMBOL sexp_istream_source_t : public sexp_byte_source_t {
+  protected:
+    std::istream *input;
+    octet_t       byte; /* window of one byte, see peek() */
+
+    virtual bool fill(void);
+
+  public:
+    sexp_istream_source_t(std::istream *i = nullptr) : input(i), byte(0) {}
+    /* the window may point to byte of this object */
+    sexp_istream_source_t(const sexp_istream_source_t &) = delete;
+    sexp_istream_source_t &operator=(const sexp_istream_source_t &) = delete;
+    sexp_istream_source_t *set_input(std::istream *i)
+    {
+        input = i;
+        next = last = nullptr;
+        return this;
+    }
+};
+
+class SEXP_PUBLIC_SYMBOL sexp_ostream_sink_t : public sexp_byte_sink_t {
+  protected:
+    std::ostream *output;
+
+  public:
+    sexp_ostream_sink_t(std::ostream *o = nullptr) : output(o) {}
+    sexp_ostream_sink_t *set_output(std::ostream *o)
+    {
+        output = o;
+        return this;
+    }
+
+    virtual void put(octet_t c) { output->put((char) c); }
+    virtual void write(const octet_t *bt, size_t ln)
+    {
+        output->write(reinterpret_cast<const char *>(bt), ln);
+    }
+    virtual void flush(void) { output->flush(); }
 };
 
 /*
@@ -411,21 +1186,71 @@ class SEXP_PUBLIC_SYMBOL sexp_depth_manager {
 
 class SEXP_PUBLIC_SYMBOL sexp_input_stream_t : public sexp_char_defs_t, sexp_depth_manager {
   protected:
-    std::istream *input_file;
-    uint32_t      byte_size; /* 4 or 6 or 8 == currently scanning mode */
-    int           next_char; /* character currently being scanned */
-    uint32_t      bits;      /* Bits waiting to be used */
-    uint32_t      n_bits;    /* number of such bits waiting to be used */
-    int           count;     /* number of 8-bit characters output by get_char */
+    sexp_istream_source_t  istream_source; /* adapter used when reading std::istream */
+    sexp_byte_source_t *   input_source;
+    uint32_t               byte_size; /* 4 or 6 or 8 == currently scanning mode */
+    int                    next_char; /* character currently being scanned */
+    uint32_t               bits;      /* Bits waiting to be used */
+    uint32_t               n_bits;    /* number of such bits waiting to be used */
+    int                    count;     /* number of 8-bit characters output by get_char */
+    sexp_intern_table_t *  intern_table;      /* shares repeated atoms, may be nullptr */
+    sexp_hashcons_table_t *hashcons_table;    /* shares repeated objects, may be nullptr */
+    size_t                 list_segment_size; /* see set_list_segment_size() */
+#ifdef SEXP_WITH_PMR
+    std::pmr::memory_resource *memory_resource = std::pmr::get_default_resource();
+#endif
 
     virtual int read_char(void);
+    size_t      buffered_length(int terminator) const;
+    size_t      scan_simple_string(sexp_simple_string_t &ss, bool keep);
 
   public:
     sexp_input_stream_t(std::istream *i,
                         size_t        max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    sexp_input_stream_t(sexp_byte_source_t *s,
+                        size_t              max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    /* input_source may point to istream_source of this object, so it is not copied */
+    sexp_input_stream_t(const sexp_input_stream_t &) = delete;
+    sexp_input_stream_t &operator=(const sexp_input_stream_t &) = delete;
     virtual ~sexp_input_stream_t() = default;
     sexp_input_stream_t *          set_input(std::istream *i,
                                              size_t max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    sexp_input_stream_t *          set_input(sexp_byte_source_t *s,
+                                             size_t max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    sexp_input_stream_t *          set_intern_table(sexp_intern_table_t *table)
+    {
+        intern_table = table;
+        return this;
+    }
+    sexp_intern_table_t *          get_intern_table(void) const noexcept { return intern_table; }
+    /* With a hash-consing table every scanned object is shared through the table;
+     * it takes precedence over the intern table */
+    sexp_input_stream_t *set_hashcons_table(sexp_hashcons_table_t *table)
+    {
+        hashcons_table = table;
+        return this;
+    }
+    sexp_hashcons_table_t *get_hashcons_table(void) const noexcept { return hashcons_table; }
+    /* Scanned lists with more than n children keep them in segments of about n, which
+     * are never moved, instead of one array that is reallocated as the list grows; see
+     * sexp_small_vector_t::set_segment_size().  0 (default) keeps children contiguous. */
+    sexp_input_stream_t *set_list_segment_size(size_t n) noexcept
+    {
+        list_segment_size = n;
+        return this;
+    }
+    size_t get_list_segment_size(void) const noexcept { return list_segment_size; }
+#ifdef SEXP_WITH_PMR
+    /* Scanned objects are allocated from mr, which must outlive them */
+    sexp_input_stream_t *set_memory_resource(std::pmr::memory_resource *mr) noexcept
+    {
+        memory_resource = mr;
+        return this;
+    }
+    sexp_allocator_t get_allocator(void) const noexcept { return memory_resource; }
+#else
+    sexp_allocator_t get_allocator(void) const noexcept { return sexp_allocator_t(); }
+#endif
     sexp_input_stream_t *          set_byte_size(uint32_t new_byte_size);
     uint32_t                       get_byte_size(void) { return byte_size; }
     sexp_input_stream_t *          get_char(void);
@@ -436,6 +1261,8 @@ class SEXP_PUBLIC_SYMBOL sexp_input_stream_t : public sexp_char_defs_t, sexp_dep
     std::shared_ptr<sexp_string_t> scan_string(void);
     std::shared_ptr<sexp_list_t>   scan_list(void);
     sexp_simple_string_t           scan_simple_string(void);
+    /* Passes over a simple string; scratch is used to check encoded strings */
+    sexp_input_stream_t *skip_simple_string(sexp_simple_string_t &scratch);
     void                           scan_token(sexp_simple_string_t &ss);
     void     scan_verbatim_string(sexp_simple_string_t &ss, uint32_t length);
     void     scan_quoted_string(sexp_simple_string_t &ss, uint32_t length);
@@ -445,6 +1272,8 @@ class SEXP_PUBLIC_SYMBOL sexp_input_stream_t : public sexp_char_defs_t, sexp_dep
 
     int get_next_char(void) const { return next_char; }
     int set_next_char(int c) { return next_char = c; }
+    /* Number of characters read so far, the position reported by errors */
+    int get_position(void) const noexcept { return count; }
 
     sexp_input_stream_t *open_list(void);
     sexp_input_stream_t *close_list(void);
@@ -464,23 +1293,32 @@ class SEXP_PUBLIC_SYMBOL sexp_output_stream_t : sexp_depth_manager {
     };
 
   protected:
-    std::ostream *  output_file;
-    uint32_t        base64_count; /* number of hex or base64 chars printed this region */
-    uint32_t        byte_size;    /* 4 or 6 or 8 depending on output mode */
-    uint32_t        bits;         /* bits waiting to go out */
-    uint32_t        n_bits;       /* number of bits waiting to go out */
-    sexp_print_mode mode;         /* base64, advanced, or canonical */
-    uint32_t        column;       /* column where next character will go */
-    uint32_t        max_column;   /* max usable column, or 0 if no maximum */
-    uint32_t        indent;       /* current indentation level (starts at 0) */
+    sexp_ostream_sink_t ostream_sink; /* adapter used when writing std::ostream */
+    sexp_byte_sink_t *  output_sink;
+    uint32_t            base64_count; /* number of hex or base64 chars printed this region */
+    uint32_t            byte_size;    /* 4 or 6 or 8 depending on output mode */
+    uint32_t            bits;         /* bits waiting to go out */
+    uint32_t            n_bits;       /* number of bits waiting to go out */
+    sexp_print_mode     mode;         /* base64, advanced, or canonical */
+    uint32_t            column;       /* column where next character will go */
+    uint32_t            max_column;   /* max usable column, or 0 if no maximum */
+    uint32_t            indent;       /* current indentation level (starts at 0) */
   public:
     sexp_output_stream_t(std::ostream *o,
                          size_t        max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    sexp_output_stream_t(sexp_byte_sink_t *s,
+                         size_t            max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    /* output_sink may point to ostream_sink of this object, so it is not copied */
+    sexp_output_stream_t(const sexp_output_stream_t &) = delete;
+    sexp_output_stream_t &operator=(const sexp_output_stream_t &) = delete;
     sexp_output_stream_t *set_output(std::ostream *o,
                                      size_t max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
+    sexp_output_stream_t *set_output(sexp_byte_sink_t *s,
+                                     size_t max_depth = sexp_depth_manager::DEFAULT_MAX_DEPTH);
     sexp_output_stream_t *put_char(int c);                /* output a character */
     sexp_output_stream_t *new_line(sexp_print_mode mode); /* go to next line (and indent) */
     sexp_output_stream_t *var_put_char(int c);
+    sexp_output_stream_t *var_put_chars(const octet_t *bt, size_t ln);
     sexp_output_stream_t *flush(void);
     sexp_output_stream_t *print_decimal(uint64_t n);
 
@@ -495,6 +1333,8 @@ class SEXP_PUBLIC_SYMBOL sexp_output_stream_t : sexp_depth_manager {
         return obj->print_advanced(this);
     };
     sexp_output_stream_t *print_base64(const std::shared_ptr<sexp_object_t> &obj);
+    sexp_output_stream_t *print_canonical_parallel(const std::shared_ptr<sexp_object_t> &obj,
+                                                   unsigned threads = 0);
     sexp_output_stream_t *print_canonical(const sexp_simple_string_t *ss)
     {
         return ss->print_canonical_verbatim(this);
@@ -553,3 +1393,29 @@ class SEXP_PUBLIC_SYMBOL sexp_output_stream_t : sexp_depth_manager {
 };
 
 } // namespace sexp
+
+namespace std {
+
+template <> struct hash<sexp::sexp_simple_string_t> {
+    size_t operator()(const sexp::sexp_simple_string_t &ss) const { return (size_t) ss.hash(); }
+};
+
+template <> struct hash<sexp::sexp_object_t> {
+    size_t operator()(const sexp::sexp_object_t &obj) const
+    {
+        return (size_t) sexp::sexp_hash(obj);
+    }
+};
+
+template <> struct hash<sexp::sexp_string_t> {
+    size_t operator()(const sexp::sexp_string_t &obj) const
+    {
+        return (size_t) sexp::sexp_hash(obj);
+    }
+};
+
+template <> struct hash<sexp::sexp_list_t> {
+    size_t operator()(const sexp::sexp_list_t &obj) const { return (size_t) sexp::sexp_hash(obj); }
+};
+
+} // namespace std
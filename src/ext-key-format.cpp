@@ -139,7 +139,7 @@ int ext_key_input_stream_t::skip_line(void)
 {
     int c;
     do {
-        c = input_file->get();
+        c = input_source->get();
     } while (!is_newline_char(c) && c != EOF);
     return c;
 }
@@ -149,20 +149,20 @@ int ext_key_input_stream_t::skip_line(void)
  */
 int ext_key_input_stream_t::read_char(void)
 {
-    int lookahead_1 = input_file->get();
+    int lookahead_1 = input_source->get();
     count++;
     if (is_scanning_value && is_newline_char(lookahead_1)) {
         while (true) {
-            int lookahead_2 = input_file->peek();
+            int lookahead_2 = input_source->peek();
             if (lookahead_1 == '\r' && lookahead_2 == '\n') {
-                lookahead_1 = input_file->get();
+                lookahead_1 = input_source->get();
                 count++;
-                lookahead_2 = input_file->peek();
+                lookahead_2 = input_source->peek();
             }
             if (lookahead_2 == ' ') {
-                input_file->get();
+                input_source->get();
                 count++;
-                lookahead_2 = input_file->peek();
+                lookahead_2 = input_source->peek();
                 if (lookahead_2 == '#') {
                     lookahead_1 = skip_line();
                     continue;
@@ -171,7 +171,7 @@ int ext_key_input_stream_t::read_char(void)
                     lookahead_1 = lookahead_2;
                     continue;
                 }
-                lookahead_1 = input_file->get();
+                lookahead_1 = input_source->get();
                 count++;
             }
             return lookahead_1;
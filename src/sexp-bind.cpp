@@ -0,0 +1,193 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexpp/sexp-bind.h"
+
+namespace sexp {
+
+namespace {
+
+std::string quoted(const octet_t *name, size_t length)
+{
+    return "'" + std::string(reinterpret_cast<const char *>(name), length) + "'";
+}
+
+std::string quoted(const char *name)
+{
+    return quoted(reinterpret_cast<const octet_t *>(name), std::strlen(name));
+}
+
+} // namespace
+
+const size_t sexp_bind_input_t::MAX_FIELDS;
+
+/*
+ * sexp_bind_input_t::open_field(sis)
+ */
+sexp_simple_string_t sexp_bind_input_t::open_field(sexp_input_stream_t *sis)
+{
+    sis->skip_white_space()->open_list()->skip_white_space();
+    if (sis->get_next_char() == '(' || sis->get_next_char() == '[')
+        sexp_error(sexp_exception_t::error, "Field name expected", sis->get_position());
+    return sis->scan_simple_string();
+}
+
+/*
+ * sexp_bind_input_t::close_field(sis)
+ */
+void sexp_bind_input_t::close_field(sexp_input_stream_t *sis)
+{
+    sis->skip_white_space();
+    if (sis->get_next_char() != ')')
+        sexp_error(
+          sexp_exception_t::error, "Field has more than one value", sis->get_position());
+    sis->close_list();
+}
+
+/*
+ * sexp_bind_input_t::skip_field(sis)
+ */
+void sexp_bind_input_t::skip_field(sexp_input_stream_t *sis)
+{
+    sis->skip_white_space();
+    while (sis->get_next_char() != ')') {
+        skip_object(sis);
+        sis->skip_white_space();
+    }
+    sis->close_list();
+}
+
+/*
+ * sexp_bind_input_t::skip_object(sis)
+ * Same syntax as sexp_input_stream_t::scan_object() without building the object.
+ * Tokens and verbatim strings are not stored, other strings are decoded into a
+ * scratch string.
+ */
+void sexp_bind_input_t::skip_object(sexp_input_stream_t *sis)
+{
+    sexp_simple_string_t scratch(sis->get_allocator());
+    sis->skip_white_space();
+    switch (sis->get_next_char()) {
+    case '(':
+        sis->open_list();
+        skip_field(sis);
+        break;
+    case '{':
+        if (sis->get_byte_size() != 6) {
+            sis->set_byte_size(6)->skip_char('{');
+            skip_object(sis);
+            sis->skip_char('}');
+            break;
+        }
+        sis->skip_simple_string(scratch);
+        break;
+    case '[':
+        sis->skip_char('[');
+        sis->skip_simple_string(scratch);
+        sis->skip_white_space()->skip_char(']')->skip_white_space();
+        sis->skip_simple_string(scratch);
+        break;
+    default:
+        sis->skip_simple_string(scratch);
+    }
+}
+
+/*
+ * sexp_bind_input_t::scan_bytes(sis)
+ */
+sexp_simple_string_t sexp_bind_input_t::scan_bytes(sexp_input_stream_t *sis)
+{
+    sis->skip_white_space();
+    if (sis->get_next_char() == '(')
+        sexp_error(sexp_exception_t::error, "String expected", sis->get_position());
+    if (sis->get_next_char() == '[')
+        sexp_error(sexp_exception_t::error,
+                   "Presentation hint is not expected in a bound field",
+                   sis->get_position());
+    return sis->scan_simple_string();
+}
+
+/*
+ * sexp_bind_input_t::scan_unsigned(sis)
+ * Scans a decimal number that fits into 32 bits
+ */
+uint32_t sexp_bind_input_t::scan_unsigned(sexp_input_stream_t *sis)
+{
+    sexp_simple_string_t ss = scan_bytes(sis);
+    uint64_t             value = 0;
+    if (ss.empty())
+        sexp_error(sexp_exception_t::error, "Unsigned number expected", sis->get_position());
+    for (octet_t c : ss) {
+        if (c < '0' || c > '9')
+            sexp_error(
+              sexp_exception_t::error, "Unsigned number expected", sis->get_position());
+        value = value * 10 + (c - '0');
+        if (value > UINT32_MAX)
+            sexp_error(
+              sexp_exception_t::error, "Unsigned number is too big", sis->get_position());
+    }
+    return (uint32_t) value;
+}
+
+/*
+ * sexp_bind_input_t::unexpected_field(sis, name, expected)
+ */
+void sexp_bind_input_t::unexpected_field(sexp_input_stream_t *       sis,
+                                         const sexp_simple_string_t &name,
+                                         const char *                expected)
+{
+    std::string msg = "Field " + quoted(expected) + " expected, " +
+                      quoted(name.data(), name.length()) + " found";
+    sexp_error(sexp_exception_t::error, msg.c_str(), sis->get_position());
+}
+
+/*
+ * sexp_bind_input_t::duplicate_field(sis, name)
+ */
+void sexp_bind_input_t::duplicate_field(sexp_input_stream_t *sis, const char *name)
+{
+    std::string msg = "Duplicate field " + quoted(name);
+    sexp_error(sexp_exception_t::error, msg.c_str(), sis->get_position());
+}
+
+/*
+ * sexp_bind_input_t::missing_field(sis, name)
+ */
+void sexp_bind_input_t::missing_field(sexp_input_stream_t *sis, const char *name)
+{
+    std::string msg = "Missing field " + quoted(name);
+    sexp_error(sexp_exception_t::error, msg.c_str(), sis->get_position());
+}
+
+/*
+ * sexp_bind_input_t::too_many_fields(sis)
+ */
+void sexp_bind_input_t::too_many_fields(sexp_input_stream_t *sis)
+{
+    sexp_error(sexp_exception_t::error,
+               "Schema declares more than %zu fields",
+               MAX_FIELDS,
+               sis->get_position());
+}
+
+} // namespace sexp
@@ -0,0 +1,242 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <cstring>
+
+#include "sexpp/sexp.h"
+
+namespace sexp {
+
+namespace {
+
+const uint64_t hash_prime = 0x9E3779B97F4A7C15ULL;
+const uint64_t string_tag = 0x736578702D737472ULL;
+const uint64_t hint_tag = 0x736578702D686E74ULL;
+const uint64_t list_tag = 0x736578702D6C7374ULL;
+
+inline uint64_t rotate(uint64_t x, unsigned r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t finalize(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t combine(uint64_t h, uint64_t v)
+{
+    return rotate(h ^ (v * hash_prime), 27) * 5 + 0x52DCE729;
+}
+
+uint64_t hash_bytes(const octet_t *data, size_t length)
+{
+    uint64_t h = length * hash_prime;
+    while (length >= 8) {
+        uint64_t w;
+        std::memcpy(&w, data, 8);
+        h = combine(h, w);
+        data += 8;
+        length -= 8;
+    }
+    uint64_t w = 0;
+    for (size_t i = 0; i < length; i++)
+        w |= (uint64_t) data[i] << (8 * i);
+    return finalize(combine(h, w));
+}
+
+/* Cached hashes use 0 for "not computed" */
+inline uint64_t nonzero(uint64_t h)
+{
+    return h != 0 ? h : 1;
+}
+
+int compare_octets(const sexp_simple_string_t &left, const sexp_simple_string_t &right)
+{
+    size_t length = std::min(left.length(), right.length());
+    int    res = length ? std::memcmp(left.data(), right.data(), length) : 0;
+    if (res != 0)
+        return res < 0 ? -1 : 1;
+    return left.length() < right.length() ? -1 : left.length() > right.length() ? 1 : 0;
+}
+
+bool equal_octets(const sexp_simple_string_t &left, const sexp_simple_string_t &right)
+{
+    return left.length() == right.length() &&
+           (left.empty() || std::memcmp(left.data(), right.data(), left.length()) == 0);
+}
+
+int compare_strings(const sexp_string_t &left, const sexp_string_t &right)
+{
+    int res = compare_octets(left.get_string(), right.get_string());
+    if (res != 0)
+        return res;
+    if (left.has_presentation_hint() != right.has_presentation_hint())
+        return left.has_presentation_hint() ? 1 : -1;
+    return left.has_presentation_hint() ?
+             compare_octets(left.get_presentation_hint(), right.get_presentation_hint()) :
+             0;
+}
+
+bool equal_strings(const sexp_string_t &left, const sexp_string_t &right)
+{
+    return equal_octets(left.get_string(), right.get_string()) &&
+           left.has_presentation_hint() == right.has_presentation_hint() &&
+           (!left.has_presentation_hint() ||
+            equal_octets(left.get_presentation_hint(), right.get_presentation_hint()));
+}
+
+/* Null elements are only possible in lists built by hand; they order first */
+int compare_elements(const std::shared_ptr<sexp_object_t> &left,
+                     const std::shared_ptr<sexp_object_t> &right)
+{
+    if (!left || !right)
+        return left ? 1 : right ? -1 : 0;
+    return left == right ? 0 : sexp_compare(*left, *right);
+}
+
+bool equal_elements(const std::shared_ptr<sexp_object_t> &left,
+                    const std::shared_ptr<sexp_object_t> &right)
+{
+    if (!left || !right)
+        return !left && !right;
+    return left == right || sexp_equal(*left, *right);
+}
+
+} // namespace
+
+/*
+ * sexp_simple_string_t::hash()
+ */
+uint64_t sexp_simple_string_t::hash(void) const
+{
+    uint64_t h = hash_value.get();
+    if (h == 0) {
+        h = nonzero(hash_bytes(data(), length()));
+        hash_value.set(h);
+    }
+    return h;
+}
+
+/*
+ * sexp_string_t::hash()
+ * Strings are immutable apart from their components which cache their own hashes,
+ * so the combination is not cached.
+ */
+uint64_t sexp_string_t::hash(void) const
+{
+    uint64_t h = combine(string_tag, data_string.hash());
+    if (presentation_hint.has_value())
+        h = combine(combine(h, hint_tag), presentation_hint.get().hash());
+    return nonzero(finalize(h));
+}
+
+/*
+ * sexp_list_t::hash()
+ * Cached for shared lists only: a list cannot tell when a descendant is modified in
+ * place, and checking the descendants costs as much as folding their hashes.  Hashing
+ * the octets, the expensive part, is cached by the strings themselves.
+ */
+uint64_t sexp_list_t::hash(void) const
+{
+    uint64_t h = shared ? shared_hash.get() : 0;
+    if (h != 0)
+        return h;
+
+    h = combine(list_tag, size());
+    for (const auto &child : *this)
+        h = combine(h, child ? sexp_hash(*child) : 0);
+    h = nonzero(finalize(h));
+    if (shared)
+        shared_hash.set(h);
+    return h;
+}
+
+/*
+ * sexp_hash(obj)
+ */
+uint64_t sexp_hash(const sexp_object_t &obj)
+{
+    if (obj.is_sexp_list())
+        return static_cast<const sexp_list_t &>(obj).hash();
+    if (obj.is_sexp_string())
+        return static_cast<const sexp_string_t &>(obj).hash();
+    return 0;
+}
+
+/*
+ * sexp_equal(left, right)
+ * Hashes are not used: a list's hash costs a full walk of both trees.
+ */
+bool sexp_equal(const sexp_object_t &left, const sexp_object_t &right)
+{
+    if (&left == &right)
+        return true;
+    if (left.is_sexp_string() && right.is_sexp_string())
+        return equal_strings(static_cast<const sexp_string_t &>(left),
+                             static_cast<const sexp_string_t &>(right));
+    if (!left.is_sexp_list() || !right.is_sexp_list())
+        return false;
+
+    const sexp_list_t &l = static_cast<const sexp_list_t &>(left);
+    const sexp_list_t &r = static_cast<const sexp_list_t &>(right);
+    if (l.size() != r.size())
+        return false;
+    for (size_t i = 0; i < l.size(); i++)
+        if (!equal_elements(l[i], r[i]))
+            return false;
+    return true;
+}
+
+/*
+ * sexp_compare(left, right)
+ * Returns negative, zero or positive value as left orders before, equal to or after
+ * right.
+ */
+int sexp_compare(const sexp_object_t &left, const sexp_object_t &right)
+{
+    if (&left == &right)
+        return 0;
+    if (left.is_sexp_string() && right.is_sexp_string())
+        return compare_strings(static_cast<const sexp_string_t &>(left),
+                               static_cast<const sexp_string_t &>(right));
+    if (!left.is_sexp_list() || !right.is_sexp_list())
+        return left.is_sexp_string() ? -1 : right.is_sexp_string() ? 1 : 0;
+
+    const sexp_list_t &l = static_cast<const sexp_list_t &>(left);
+    const sexp_list_t &r = static_cast<const sexp_list_t &>(right);
+    size_t             length = std::min(l.size(), r.size());
+    for (size_t i = 0; i < length; i++) {
+        int res = compare_elements(l[i], r[i]);
+        if (res != 0)
+            return res;
+    }
+    return l.size() < r.size() ? -1 : l.size() > r.size() ? 1 : 0;
+}
+
+} // namespace sexp
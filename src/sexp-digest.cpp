@@ -0,0 +1,241 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexpp/sexp-digest.h"
+
+namespace sexp {
+
+namespace {
+
+const uint32_t sha1_init[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+const uint32_t sha256_init[8] = {0x6a09e667,
+                                 0xbb67ae85,
+                                 0x3c6ef372,
+                                 0xa54ff53a,
+                                 0x510e527f,
+                                 0x9b05688c,
+                                 0x1f83d9ab,
+                                 0x5be0cd19};
+
+const uint32_t sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+  0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+  0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+  0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+  0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+  0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+  0xc67178f2};
+
+inline uint32_t rotl(uint32_t x, unsigned n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+inline uint32_t rotr(uint32_t x, unsigned n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t load_be32(const octet_t *bt)
+{
+    return (uint32_t(bt[0]) << 24) | (uint32_t(bt[1]) << 16) | (uint32_t(bt[2]) << 8) |
+           uint32_t(bt[3]);
+}
+
+inline void store_be32(octet_t *bt, uint32_t v)
+{
+    bt[0] = octet_t(v >> 24);
+    bt[1] = octet_t(v >> 16);
+    bt[2] = octet_t(v >> 8);
+    bt[3] = octet_t(v);
+}
+
+void sha1_compress(uint32_t state[5], const octet_t *bt)
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++)
+        w[i] = load_be32(bt + 4 * i);
+    for (int i = 16; i < 80; i++)
+        w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t t = rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = t;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+void sha256_compress(uint32_t state[8], const octet_t *bt)
+{
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++)
+        w[i] = load_be32(bt + 4 * i);
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + sha256_k[i] + w[i];
+        uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+} // namespace
+
+/*
+ * sexp_digest_sink_t::compress(bt)
+ * Processes one 64-byte block.
+ */
+void sexp_digest_sink_t::compress(const octet_t *bt)
+{
+    if (algorithm == sha1)
+        sha1_compress(state, bt);
+    else
+        sha256_compress(state, bt);
+}
+
+/*
+ * sexp_digest_sink_t::write(bt, ln)
+ * Whole blocks are hashed in place, without copying.
+ */
+void sexp_digest_sink_t::write(const octet_t *bt, size_t ln)
+{
+    length += ln;
+    if (used > 0) {
+        size_t chunk = std::min(ln, sizeof(block) - used);
+        memcpy(block + used, bt, chunk);
+        used += chunk;
+        bt += chunk;
+        ln -= chunk;
+        if (used < sizeof(block))
+            return;
+        compress(block);
+        used = 0;
+    }
+    for (; ln >= sizeof(block); bt += sizeof(block), ln -= sizeof(block))
+        compress(bt);
+    memcpy(block, bt, ln);
+    used = ln;
+}
+
+/*
+ * sexp_digest_sink_t::reset()
+ */
+void sexp_digest_sink_t::reset(void)
+{
+    if (algorithm == sha1)
+        std::copy(sha1_init, sha1_init + 5, state);
+    else
+        std::copy(sha256_init, sha256_init + 8, state);
+    length = 0;
+    used = 0;
+}
+
+/*
+ * sexp_digest_sink_t::finish()
+ * Pads the message with 0x80, zeroes and the bit length, as both algorithms do.
+ */
+octet_string sexp_digest_sink_t::finish(void)
+{
+    uint64_t bits = length * 8;
+    block[used++] = 0x80;
+    if (used > sizeof(block) - 8) {
+        memset(block + used, 0, sizeof(block) - used);
+        compress(block);
+        used = 0;
+    }
+    memset(block + used, 0, sizeof(block) - 8 - used);
+    store_be32(block + 56, uint32_t(bits >> 32));
+    store_be32(block + 60, uint32_t(bits));
+    compress(block);
+
+    octet_string res(digest_size(), 0);
+    for (size_t i = 0; i < digest_size() / 4; i++)
+        store_be32(&res[4 * i], state[i]);
+    reset();
+    return res;
+}
+
+/*
+ * canonical_digest(obj, alg)
+ */
+octet_string canonical_digest(const sexp_object_t &obj, sexp_digest_sink_t::algorithm_t alg)
+{
+    sexp_digest_sink_t   sink(alg);
+    sexp_output_stream_t os(&sink);
+    obj.print_canonical(&os);
+    return sink.finish();
+}
+
+} // namespace sexp
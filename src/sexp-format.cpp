@@ -0,0 +1,247 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "sexpp/sexp-format.h"
+#include "sexpp/sexp-io.h"
+
+namespace sexp {
+
+namespace {
+
+/* Formats at more addresses than this are compiled on every use */
+const size_t MAX_CACHED_FORMATS = 1024;
+/* The cache is split into shards with separate locks to keep contention low */
+const size_t FORMAT_SHARDS = 16;
+
+/* Room for the longest decimal uint64_t, a sign and the ':' of a length prefix */
+const size_t DECIMAL_ROOM = 22;
+
+/*
+ * put_decimal(end, n)
+ * Writes the decimal digits of n before end, returns the start of the digits
+ */
+char *put_decimal(char *end, uint64_t n)
+{
+    do {
+        *--end = (char) ('0' + n % 10);
+        n /= 10;
+    } while (n);
+    return end;
+}
+
+/*
+ * put_atom(os, bt, ln)
+ * Prints the verbatim atom ln:bt
+ */
+void put_atom(sexp_output_stream_t *os, const octet_t *bt, size_t ln)
+{
+    char  prefix[DECIMAL_ROOM];
+    char *end = prefix + sizeof(prefix);
+    *--end = ':';
+    char *start = put_decimal(end, ln);
+    end = prefix + sizeof(prefix);
+    os->var_put_chars(reinterpret_cast<const octet_t *>(start), end - start);
+    os->var_put_chars(bt, ln);
+}
+
+/*
+ * put_number(os, n, negative)
+ * Prints the decimal atom of n, with a leading '-' if negative
+ */
+void put_number(sexp_output_stream_t *os, uint64_t n, bool negative)
+{
+    char  atom[2 * DECIMAL_ROOM];
+    char *end = atom + sizeof(atom);
+    char *start = put_decimal(end, n);
+    if (negative)
+        *--start = '-';
+    size_t length = end - start;
+    *--start = ':';
+    start = put_decimal(start, length);
+    os->var_put_chars(reinterpret_cast<const octet_t *>(start), end - start);
+}
+
+} // namespace
+
+/*
+ * sexp_format_t::sexp_format_t(format)
+ * Compiles format into runs of canonical constants separated by directives
+ */
+sexp_format_t::sexp_format_t(const char *format) : directives(0)
+{
+    sexp_memory_source_t source(format, std::strlen(format));
+    sexp_input_stream_t  is(&source);
+    sexp_memory_sink_t   sink;
+    sexp_output_stream_t os(&sink);
+    size_t               depth = 0;
+    size_t               objects = 0;
+    size_t               offset = 0;
+
+    for (is.skip_white_space(); is.get_next_char() != EOF; is.skip_white_space()) {
+        int c = is.get_next_char();
+        if (depth == 0 && c != ')' && objects++ != 0)
+            sexp_error(sexp_exception_t::error,
+                       "Format shall contain a single object",
+                       is.get_position());
+        if (c == '(') {
+            is.open_list();
+            os.var_put_char('(');
+            depth++;
+        } else if (c == ')') {
+            if (depth == 0)
+                sexp_error(sexp_exception_t::error, "Unbalanced ')'", is.get_position());
+            is.close_list();
+            os.var_put_char(')');
+            depth--;
+        } else if (c == '%') {
+            is.get_char();
+            c = is.get_next_char();
+            if (c == EOF)
+                sexp_error(
+                  sexp_exception_t::error, "Truncated format directive", is.get_position());
+            if (c != 's' && c != 'b' && c != 'u' && c != 'd' && c != 'S')
+                sexp_error(sexp_exception_t::error,
+                           "Unknown format directive '%c'",
+                           c,
+                           is.get_position());
+            is.get_char();
+            steps.push_back({offset, sink.str().length() - offset, (char) c});
+            offset = sink.str().length();
+            directives++;
+        } else
+            is.scan_string()->print_canonical(&os);
+    }
+    if (objects == 0)
+        sexp_error(sexp_exception_t::error, "Format is empty", is.get_position());
+    if (depth != 0)
+        sexp_error(sexp_exception_t::error, "Format has unclosed lists", is.get_position());
+    steps.push_back({offset, sink.str().length() - offset, 0});
+    constants = sink.str();
+}
+
+/*
+ * sexp_format_t::put_arg(os, directive, arg)
+ */
+void sexp_format_t::put_arg(sexp_output_stream_t *   os,
+                            char                     directive,
+                            const sexp_format_arg_t &arg) const
+{
+    sexp_format_arg_t::kind_t kind = arg.get_kind();
+    switch (directive) {
+    case 's':
+    case 'b':
+        if (kind == sexp_format_arg_t::bytes_kind)
+            return put_atom(os, arg.get_data(), arg.get_length());
+        break;
+    case 'u':
+        if (kind == sexp_format_arg_t::unsigned_kind)
+            return put_number(os, arg.get_unsigned(), false);
+        if (kind == sexp_format_arg_t::signed_kind && arg.get_signed() >= 0)
+            return put_number(os, (uint64_t) arg.get_signed(), false);
+        break;
+    case 'd':
+        if (kind == sexp_format_arg_t::unsigned_kind)
+            return put_number(os, arg.get_unsigned(), false);
+        if (kind == sexp_format_arg_t::signed_kind) {
+            int64_t v = arg.get_signed();
+            return put_number(os, v < 0 ? 0 - (uint64_t) v : (uint64_t) v, v < 0);
+        }
+        break;
+    case 'S':
+        if (kind == sexp_format_arg_t::object_kind) {
+            arg.get_object()->print_canonical(os);
+            return;
+        }
+        break;
+    }
+    sexp_error(sexp_exception_t::error,
+               "Argument does not match format directive '%%%c'",
+               directive,
+               EOF);
+}
+
+/*
+ * sexp_format_t::print(os, args, count)
+ */
+sexp_output_stream_t *sexp_format_t::print(sexp_output_stream_t *   os,
+                                           const sexp_format_arg_t *args,
+                                           size_t                   count) const
+{
+    if (count != directives)
+        sexp_error(sexp_exception_t::error,
+                   "Format takes %zu arguments, %zu given",
+                   directives,
+                   count,
+                   EOF);
+    for (const step_t &step : steps) {
+        if (step.length)
+            os->var_put_chars(
+              reinterpret_cast<const octet_t *>(constants.data()) + step.offset, step.length);
+        if (step.directive)
+            put_arg(os, step.directive, *args++);
+    }
+    return os;
+}
+
+/*
+ * sexp_format_t::compiled(format)
+ * Formats are cached by address in shards selected by the address.  The text is kept
+ * with the compiled format and compared on every hit, in one pass that stops at the
+ * first difference, so a buffer reused for another format is compiled again rather
+ * than printed with a stale format.  Callers share ownership, so replacing an entry
+ * does not affect a print in progress.
+ */
+std::shared_ptr<const sexp_format_t> sexp_format_t::compiled(const char *format)
+{
+    struct entry_t {
+        std::string                          text;
+        std::shared_ptr<const sexp_format_t> compiled;
+    };
+    struct shard_t {
+        std::mutex                                lock;
+        std::unordered_map<const char *, entry_t> cache;
+    };
+    static shard_t shards[FORMAT_SHARDS];
+
+    /* formats are not aligned, the low bits take part in the selection */
+    size_t                      index = std::hash<const char *>()(format) % FORMAT_SHARDS;
+    std::lock_guard<std::mutex> guard(shards[index].lock);
+    auto &                      cache = shards[index].cache;
+    auto                        found = cache.find(format);
+    if (found != cache.end() && std::strcmp(found->second.text.c_str(), format) == 0)
+        return found->second.compiled;
+
+    auto fresh = std::make_shared<const sexp_format_t>(format);
+    if (found != cache.end()) {
+        found->second.text = format;
+        found->second.compiled = fresh;
+    } else if (cache.size() < MAX_CACHED_FORMATS / FORMAT_SHARDS)
+        cache.emplace(format, entry_t{format, fresh});
+    return fresh;
+}
+
+} // namespace sexp
@@ -0,0 +1,140 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexpp/sexp-hashcons.h"
+
+namespace sexp {
+
+const size_t sexp_hashcons_table_t::SHARDS;
+
+namespace {
+
+/*
+ * set_shared(obj)
+ * Elements of a shared list are reachable from every tree holding the list.  Elements
+ * of lists scanned with the table are shared already, so the walk stops there.
+ */
+void set_shared(sexp_object_t &obj)
+{
+    if (obj.is_shared())
+        return;
+    obj.set_shared();
+    sexp_list_t *list = obj.sexp_list_view();
+    if (list != nullptr)
+        for (const auto &child : *list)
+            if (child)
+                set_shared(*child);
+}
+
+} // namespace
+
+/*
+ * sexp_hashcons_table_t::can_share(obj)
+ * With token_atoms a list qualifies if all its elements that are not shared yet
+ * qualify.
+ */
+bool sexp_hashcons_table_t::can_share(const sexp_object_t &obj) const
+{
+    if (atoms == all_atoms || obj.is_shared())
+        return true;
+    if (obj.is_sexp_string()) {
+        const sexp_string_t &str = static_cast<const sexp_string_t &>(obj);
+        return !str.has_presentation_hint() && str.get_string().can_print_as_token();
+    }
+    if (!obj.is_sexp_list())
+        return false;
+    for (const auto &child : static_cast<const sexp_list_t &>(obj))
+        if (child && !can_share(*child))
+            return false;
+    return true;
+}
+
+/*
+ * sexp_hashcons_table_t::share(obj)
+ * The shard is selected by the high bits of the hash, the buckets of the shard use
+ * the low ones.
+ */
+std::shared_ptr<sexp_object_t> sexp_hashcons_table_t::share(
+  const std::shared_ptr<sexp_object_t> &obj)
+{
+    if (!can_share(*obj))
+        return obj;
+    shard_t &                   shard = shards[(sexp_hash(*obj) >> 56) % SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto                        res = shard.nodes.insert(obj);
+    if (res.second)
+        set_shared(*obj);
+    return *res.first;
+}
+
+/*
+ * sexp_hashcons_table_t::size()
+ * Returns the number of shared nodes.
+ */
+size_t sexp_hashcons_table_t::size(void)
+{
+    size_t res = 0;
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        res += shard.nodes.size();
+    }
+    return res;
+}
+
+/*
+ * sexp_hashcons_table_t::purge()
+ * A purged list may release the last references to its elements, so shards are
+ * swept until nothing more is released.
+ */
+size_t sexp_hashcons_table_t::purge(void)
+{
+    size_t res = 0;
+    for (size_t released = 1; released != 0; res += released) {
+        released = 0;
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            for (auto it = shard.nodes.begin(); it != shard.nodes.end();) {
+                if (it->use_count() == 1) {
+                    it = shard.nodes.erase(it);
+                    released++;
+                } else
+                    ++it;
+            }
+        }
+    }
+    return res;
+}
+
+/*
+ * sexp_hashcons_table_t::clear()
+ * Forgets all nodes; nodes still referenced by trees stay valid.
+ */
+void sexp_hashcons_table_t::clear(void)
+{
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.nodes.clear();
+    }
+}
+
+} // namespace sexp
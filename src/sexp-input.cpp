@@ -27,6 +27,8 @@
  */
 
 #include "sexpp/sexp.h"
+#include "sexpp/sexp-hashcons.h"
+#include "sexpp/sexp-intern.h"
 
 namespace sexp {
 
@@ -36,17 +38,33 @@ namespace sexp {
  */
 
 sexp_input_stream_t::sexp_input_stream_t(std::istream *i, size_t m_depth)
+    : intern_table(nullptr), hashcons_table(nullptr), list_segment_size(0)
 {
     set_input(i, m_depth);
 }
 
+sexp_input_stream_t::sexp_input_stream_t(sexp_byte_source_t *s, size_t m_depth)
+    : intern_table(nullptr), hashcons_table(nullptr), list_segment_size(0)
+{
+    set_input(s, m_depth);
+}
+
 /*
  * sexp_input_stream_t::set_input(std::istream *i, size_t m_depth)
  */
 
 sexp_input_stream_t *sexp_input_stream_t::set_input(std::istream *i, size_t m_depth)
 {
-    input_file = i;
+    return set_input(istream_source.set_input(i), m_depth);
+}
+
+/*
+ * sexp_input_stream_t::set_input(sexp_byte_source_t *s, size_t m_depth)
+ */
+
+sexp_input_stream_t *sexp_input_stream_t::set_input(sexp_byte_source_t *s, size_t m_depth)
+{
+    input_source = s;
     byte_size = 8;
     next_char = ' ';
     bits = 0;
@@ -70,7 +88,29 @@ sexp_input_stream_t *sexp_input_stream_t::set_byte_size(uint32_t newByteSize)
 int sexp_input_stream_t::read_char(void)
 {
     count++;
-    return input_file->get();
+    return input_source->get();
+}
+
+/*
+ * sexp_input_stream_t::buffered_length(terminator)
+ * Returns the number of buffered input characters before terminator, 0 if there is
+ * no terminator among them.  If terminator is EOF, returns the number of buffered
+ * token characters.  Used to reserve strings before they are scanned.
+ */
+size_t sexp_input_stream_t::buffered_length(int terminator) const
+{
+    size_t         ln;
+    const octet_t *bt = input_source->buffered(ln);
+    if (ln == 0)
+        return 0;
+    if (terminator != EOF) {
+        const void *end = std::memchr(bt, terminator, ln);
+        return end != nullptr ? static_cast<const octet_t *>(end) - bt : 0;
+    }
+    size_t i = 0;
+    while (i < ln && is_token_char(bt[i]))
+        i++;
+    return i;
 }
 
 /*
@@ -168,6 +208,7 @@ sexp_input_stream_t *sexp_input_stream_t::skip_char(int c)
 void sexp_input_stream_t::scan_token(sexp_simple_string_t &ss)
 {
     skip_white_space();
+    ss.reserve(1 + buffered_length(EOF));
     while (is_token_char(next_char)) {
         ss.append(next_char);
         get_char();
@@ -181,13 +222,13 @@ void sexp_input_stream_t::scan_token(sexp_simple_string_t &ss)
  */
 std::shared_ptr<sexp_object_t> sexp_input_stream_t::scan_to_eof(void)
 {
-    sexp_simple_string_t ss;
+    sexp_simple_string_t ss(get_allocator());
     skip_white_space();
     while (next_char != EOF) {
         ss.append(next_char);
         get_char();
     }
-    auto s = std::make_shared<sexp_string_t>();
+    auto s = std::allocate_shared<sexp_string_t>(get_allocator());
     s->set_string(ss);
     return s;
 }
@@ -223,6 +264,7 @@ void sexp_input_stream_t::scan_verbatim_string(sexp_simple_string_t &ss, uint32_
     if (length > 1024 * 1024) {
         sexp_error(sexp_exception_t::error, "Verbatim string is too long: %zu", length, count);
     }
+    ss.reserve(length);
     for (uint32_t i = 0; i < length; i++) {
         if (next_char == EOF) {
             sexp_error(
@@ -242,6 +284,8 @@ void sexp_input_stream_t::scan_verbatim_string(sexp_simple_string_t &ss, uint32_
 void sexp_input_stream_t::scan_quoted_string(sexp_simple_string_t &ss, uint32_t length)
 {
     skip_char('"');
+    if (next_char != '"')
+        ss.reserve(1 + buffered_length('"'));
     while (ss.length() <= length) {
         if (next_char == '\"') {
             if (length == std::numeric_limits<uint32_t>::max() || (ss.length() == length)) {
@@ -360,6 +404,8 @@ void sexp_input_stream_t::scan_quoted_string(sexp_simple_string_t &ss, uint32_t
 void sexp_input_stream_t::scan_hexadecimal_string(sexp_simple_string_t &ss, uint32_t length)
 {
     set_byte_size(4)->skip_char('#');
+    if (next_char != '#')
+        ss.reserve((2 + buffered_length('#')) / 2);
     while (next_char != EOF && (next_char != '#' || get_byte_size() == 4)) {
         ss.append(next_char);
         get_char();
@@ -382,6 +428,8 @@ void sexp_input_stream_t::scan_hexadecimal_string(sexp_simple_string_t &ss, uint
 void sexp_input_stream_t::scan_base64_string(sexp_simple_string_t &ss, uint32_t length)
 {
     set_byte_size(6)->skip_char('|');
+    if (next_char != '|')
+        ss.reserve((2 + buffered_length('|')) * 3 / 4);
     while (next_char != EOF && (next_char != '|' || get_byte_size() == 6)) {
         ss.append(next_char);
         get_char();
@@ -396,22 +444,27 @@ void sexp_input_stream_t::scan_base64_string(sexp_simple_string_t &ss, uint32_t
 }
 
 /*
- * sexp_input_stream_t::scan_simple_string(void)
- * Reads and returns a simple string from the input stream.
+ * sexp_input_stream_t::scan_simple_string(ss, keep)
+ * Reads a simple string from the input stream into ss and returns its length.
  * Determines type of simple string from the initial character, and
- * dispatches to appropriate routine based on that.
+ * dispatches to appropriate routine based on that.  Unless keep is set, tokens and
+ * verbatim strings are passed over without being stored.
  */
-sexp_simple_string_t sexp_input_stream_t::scan_simple_string(void)
+size_t sexp_input_stream_t::scan_simple_string(sexp_simple_string_t &ss, bool keep)
 {
-    uint32_t             length;
-    sexp_simple_string_t ss;
+    uint32_t length;
+    size_t   skipped = 0;
     skip_white_space();
     /* Note that it is important in the following code to test for token-ness
      * before checking the other cases, so that a token may begin with ":",
      * which would otherwise be treated as a verbatim string missing a length.
      */
     if (is_token_char(next_char) && !is_dec_digit(next_char)) {
-        scan_token(ss);
+        if (keep)
+            scan_token(ss);
+        else
+            for (; is_token_char(next_char); skipped++)
+                get_char();
     } else {
         length = is_dec_digit(next_char) ? scan_decimal_string() :
                                            std::numeric_limits<uint32_t>::max();
@@ -428,7 +481,17 @@ sexp_simple_string_t sexp_input_stream_t::scan_simple_string(void)
             break;
         case ':':
             // ':' is 'tokenchar', so some length shall be defined
-            scan_verbatim_string(ss, length);
+            if (keep) {
+                scan_verbatim_string(ss, length);
+                break;
+            }
+            skip_white_space()->skip_char(':');
+            for (; skipped < length; skipped++) {
+                if (next_char == EOF)
+                    sexp_error(
+                      sexp_exception_t::error, "EOF while reading verbatim string", count);
+                get_char();
+            }
             break;
         default: {
             const char *const msg = (next_char == EOF) ? "unexpected end of file" :
@@ -439,19 +502,55 @@ sexp_simple_string_t sexp_input_stream_t::scan_simple_string(void)
         }
     }
 
-    if (ss.length() == 0)
+    if (skipped + ss.length() == 0)
         sexp_error(sexp_exception_t::warning, "Simple string has zero length", count);
+    return skipped + ss.length();
+}
+
+/*
+ * sexp_input_stream_t::scan_simple_string(void)
+ * Reads and returns a simple string from the input stream.
+ */
+sexp_simple_string_t sexp_input_stream_t::scan_simple_string(void)
+{
+    sexp_simple_string_t ss(get_allocator());
+    scan_simple_string(ss, true);
     return ss;
 }
 
+/*
+ * sexp_input_stream_t::skip_simple_string(scratch)
+ * Same syntax as scan_simple_string() without keeping the string.  Tokens and
+ * verbatim strings are passed over without being stored; quoted, hexadecimal and
+ * base64 strings are decoded into scratch, which is cleared first, so scratch may be
+ * reused for all strings that are skipped.
+ */
+sexp_input_stream_t *sexp_input_stream_t::skip_simple_string(sexp_simple_string_t &scratch)
+{
+    scratch.clear();
+    scan_simple_string(scratch, false);
+    return this;
+}
+
 /*
  * sexp_input_stream_t::scan_string(void)
  * Reads and returns a string [presentationhint]string from input stream.
  */
 std::shared_ptr<sexp_string_t> sexp_input_stream_t::scan_string(void)
 {
-    auto s = std::make_shared<sexp_string_t>();
-    ;
+    if (hashcons_table != nullptr) {
+        auto s = std::allocate_shared<sexp_string_t>(get_allocator());
+        s->parse(this);
+        return hashcons_table->share(s);
+    }
+    if (intern_table != nullptr) {
+        sexp_string_t s(get_allocator());
+        s.parse(this);
+        if (intern_table->can_intern(s))
+            return intern_table->intern(std::move(s));
+        return std::allocate_shared<sexp_string_t>(get_allocator(), std::move(s));
+    }
+    auto s = std::allocate_shared<sexp_string_t>(get_allocator());
     s->parse(this);
     return s;
 }
@@ -462,9 +561,9 @@ std::shared_ptr<sexp_string_t> sexp_input_stream_t::scan_string(void)
  */
 std::shared_ptr<sexp_list_t> sexp_input_stream_t::scan_list(void)
 {
-    auto list = std::make_shared<sexp_list_t>();
+    auto list = std::allocate_shared<sexp_list_t>(get_allocator());
     list->parse(this);
-    return list;
+    return hashcons_table != nullptr ? hashcons_table->share(list) : list;
 }
 
 /*
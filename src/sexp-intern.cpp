@@ -0,0 +1,130 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexpp/sexp-intern.h"
+
+namespace sexp {
+
+const size_t sexp_intern_table_t::DEFAULT_MAX_LENGTH;
+const size_t sexp_intern_table_t::SHARDS;
+
+/*
+ * sexp_intern_table_t::key(str)
+ * Hint and data separated by a character that is not allowed in tokens.
+ */
+std::string sexp_intern_table_t::key(const sexp_string_t &str)
+{
+    const auto &data = str.get_string();
+    std::string res;
+    if (str.has_presentation_hint()) {
+        const auto &hint = str.get_presentation_hint();
+        res.reserve(hint.length() + data.length() + 1);
+        res.append(reinterpret_cast<const char *>(hint.data()), hint.length());
+    }
+    res.push_back(' ');
+    res.append(reinterpret_cast<const char *>(data.data()), data.length());
+    return res;
+}
+
+/*
+ * sexp_intern_table_t::can_intern(str)
+ */
+bool sexp_intern_table_t::can_intern(const sexp_string_t &str) const
+{
+    const auto &data = str.get_string();
+    if (data.length() > max_length || !data.can_print_as_token())
+        return false;
+    if (!str.has_presentation_hint())
+        return true;
+    const auto &hint = str.get_presentation_hint();
+    return hint.length() <= max_length && hint.can_print_as_token();
+}
+
+/*
+ * sexp_intern_table_t::lookup(k, str)
+ * Finds the node for key k, adds str as the node if there is none.
+ */
+std::shared_ptr<sexp_string_t> sexp_intern_table_t::lookup(const std::string &k,
+                                                           sexp_string_t &&   str)
+{
+    shard_t &                   shard = shards[std::hash<std::string>()(k) % SHARDS];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto                        it = shard.nodes.find(k);
+    if (it != shard.nodes.end())
+        return it->second;
+#ifdef SEXP_WITH_PMR
+    /* copied, not moved: the table must not keep memory of the caller's resource */
+    auto node = std::make_shared<sexp_string_t>(static_cast<const sexp_string_t &>(str));
+#else
+    auto node = std::make_shared<sexp_string_t>(std::move(str));
+#endif
+    node->set_shared();
+    shard.nodes.emplace(k, node);
+    return node;
+}
+
+/*
+ * sexp_intern_table_t::intern(str)
+ */
+std::shared_ptr<sexp_string_t> sexp_intern_table_t::intern(sexp_string_t &&str)
+{
+    if (!can_intern(str))
+        return std::make_shared<sexp_string_t>(std::move(str));
+    return lookup(key(str), std::move(str));
+}
+
+/*
+ * sexp_intern_table_t::intern(token)
+ */
+std::shared_ptr<sexp_string_t> sexp_intern_table_t::intern(const std::string &token)
+{
+    return intern(sexp_string_t(reinterpret_cast<const octet_t *>(token.data()), token.size()));
+}
+
+/*
+ * sexp_intern_table_t::size()
+ * Returns the number of interned nodes.
+ */
+size_t sexp_intern_table_t::size(void)
+{
+    size_t res = 0;
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        res += shard.nodes.size();
+    }
+    return res;
+}
+
+/*
+ * sexp_intern_table_t::clear()
+ * Forgets all nodes; nodes still referenced by trees stay valid.
+ */
+void sexp_intern_table_t::clear(void)
+{
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.nodes.clear();
+    }
+}
+
+} // namespace sexp
@@ -0,0 +1,178 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <cerrno>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "sexpp/sexp-io.h"
+
+namespace sexp {
+
+/*
+ * sexp_byte_source_t::read(bt, ln)
+ */
+size_t sexp_byte_source_t::read(octet_t *bt, size_t ln)
+{
+    size_t done = 0;
+    while (done < ln && (next < last || fill())) {
+        size_t chunk = std::min(ln - done, (size_t) (last - next));
+        memcpy(bt + done, next, chunk);
+        next += chunk;
+        done += chunk;
+    }
+    return done;
+}
+
+/*
+ * sexp_byte_sink_t::write(bt, ln)
+ * Default implementation, sinks that can do better override it.
+ */
+void sexp_byte_sink_t::write(const octet_t *bt, size_t ln)
+{
+    for (size_t i = 0; i < ln; i++)
+        put(bt[i]);
+}
+
+/*
+ * sexp_istream_source_t::fill()
+ * Takes a single byte from the stream so that nothing beyond what the parser
+ * consumes is read.
+ */
+bool sexp_istream_source_t::fill(void)
+{
+    int c = input->get();
+    if (c == EOF)
+        return false;
+    byte = (octet_t) c;
+    next = &byte;
+    last = &byte + 1;
+    return true;
+}
+
+/*
+ * sexp_buffered_source_t::fill()
+ */
+bool sexp_buffered_source_t::fill(void)
+{
+    size_t ln = read_some(buffer.data(), buffer.size());
+    if (ln == 0)
+        return false;
+    next = buffer.data();
+    last = next + ln;
+    return true;
+}
+
+/*
+ * sexp_buffered_sink_t::write(bt, ln)
+ * Blocks that do not fit into the buffer are delivered directly.
+ */
+void sexp_buffered_sink_t::write(const octet_t *bt, size_t ln)
+{
+    if (ln <= buffer.size() - used) {
+        memcpy(buffer.data() + used, bt, ln);
+        used += ln;
+        return;
+    }
+    flush();
+    if (ln < buffer.size()) {
+        memcpy(buffer.data(), bt, ln);
+        used = ln;
+    } else
+        drain(bt, ln);
+}
+
+/*
+ * sexp_buffered_sink_t::flush()
+ */
+void sexp_buffered_sink_t::flush(void)
+{
+    if (used == 0)
+        return;
+    size_t ln = used;
+    used = 0;
+    drain(buffer.data(), ln);
+}
+
+/*
+ * sexp_callback_sink_t::~sexp_callback_sink_t()
+ * Delivers buffered bytes; errors cannot be reported from here, so call flush()
+ * explicitly when they matter.
+ */
+sexp_callback_sink_t::~sexp_callback_sink_t()
+{
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+#ifndef _WIN32
+/*
+ * sexp_fd_source_t::read_some(bt, ln)
+ */
+size_t sexp_fd_source_t::read_some(octet_t *bt, size_t ln)
+{
+    while (true) {
+        ssize_t res = ::read(fd, bt, ln);
+        if (res >= 0)
+            return res;
+        if (errno != EINTR) {
+            sexp_error(sexp_exception_t::error, "read failed with error %zu", errno, EOF);
+            return 0;
+        }
+    }
+}
+
+/*
+ * sexp_fd_sink_t::drain(bt, ln)
+ */
+void sexp_fd_sink_t::drain(const octet_t *bt, size_t ln)
+{
+    while (ln > 0) {
+        ssize_t res = ::write(fd, bt, ln);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            sexp_error(sexp_exception_t::error, "write failed with error %zu", errno, EOF);
+            return;
+        }
+        bt += res;
+        ln -= res;
+    }
+}
+
+/*
+ * sexp_fd_sink_t::~sexp_fd_sink_t()
+ */
+sexp_fd_sink_t::~sexp_fd_sink_t()
+{
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+#endif
+
+} // namespace sexp
@@ -0,0 +1,232 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <cerrno>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "sexpp/sexp-iovec.h"
+
+#if !defined(_WIN32) && !defined(IOV_MAX)
+#define IOV_MAX 1024
+#endif
+
+namespace sexp {
+
+const size_t sexp_iovec_t::DEFAULT_INLINE_LIMIT;
+
+/*
+ * sexp_iovec_t::sexp_iovec_t
+ * Creates and initializes new sexp_iovec_t object.
+ */
+sexp_iovec_t::sexp_iovec_t(size_t i_limit, size_t m_depth)
+    : sexp_depth_manager(m_depth), total(0), inline_limit(i_limit)
+{
+}
+
+/*
+ * sexp_iovec_t::clear()
+ * Drops all segments, so the object can be reused.
+ */
+sexp_iovec_t *sexp_iovec_t::clear(void)
+{
+    headers.clear();
+    parts.clear();
+    total = 0;
+    return this;
+}
+
+/*
+ * sexp_iovec_t::put_generated(bt, ln)
+ * Appends bytes to the generated buffer, extending the last segment if it is
+ * generated as well.
+ */
+void sexp_iovec_t::put_generated(const octet_t *bt, size_t ln)
+{
+    if (parts.empty() || parts.back().data != nullptr)
+        parts.push_back({nullptr, headers.length(), 0});
+    headers.append(bt, ln);
+    parts.back().length += ln;
+    total += ln;
+}
+
+void sexp_iovec_t::put_char(int c)
+{
+    octet_t o = (octet_t) c;
+    put_generated(&o, 1);
+}
+
+/*
+ * sexp_iovec_t::put_simple_string(ss)
+ * Appends verbatim image of simple string: length prefix and the contents.
+ */
+void sexp_iovec_t::put_simple_string(const sexp_simple_string_t &ss)
+{
+    char   prefix[24];
+    size_t n = snprintf(prefix, sizeof(prefix), "%zu:", ss.length());
+    put_generated(reinterpret_cast<const octet_t *>(prefix), n);
+    if (ss.length() < inline_limit)
+        put_generated(ss.data(), ss.length());
+    else {
+        parts.push_back({ss.data(), 0, ss.length()});
+        total += ss.length();
+    }
+}
+
+/*
+ * sexp_iovec_t::put_object(obj)
+ * Appends canonical image of the object, checking nesting depth of lists.
+ */
+void sexp_iovec_t::put_object(const sexp_object_t &obj)
+{
+    /* sexp_list_view and sexp_string_view are not const, although they do not modify obj */
+    sexp_object_t &o = const_cast<sexp_object_t &>(obj);
+    if (o.is_sexp_list()) {
+        put_char('(');
+        increase_depth();
+        for (const auto &child : *o.sexp_list_view())
+            put_object(*child);
+        decrease_depth();
+        put_char(')');
+    } else if (o.is_sexp_string()) {
+        const sexp_string_t *str = o.sexp_string_view();
+        if (str->has_presentation_hint()) {
+            put_char('[');
+            put_simple_string(str->get_presentation_hint());
+            put_char(']');
+        }
+        put_simple_string(str->get_string());
+    }
+}
+
+/*
+ * sexp_iovec_t::add(obj)
+ * Appends canonical image of the object to the segments.
+ */
+sexp_iovec_t *sexp_iovec_t::add(const sexp_object_t &obj)
+{
+    /* if obj cannot be added, segments and depth are left as they were */
+    struct rollback_t {
+        sexp_iovec_t &iov;
+        depth_guard_t depth;
+        size_t        headers_length;
+        size_t        parts_count;
+        size_t        last_length;
+        size_t        total;
+        bool          done;
+
+        rollback_t(sexp_iovec_t &i)
+            : iov(i), depth(i), headers_length(i.headers.length()),
+              parts_count(i.parts.size()),
+              last_length(i.parts.empty() ? 0 : i.parts.back().length), total(i.total),
+              done(false)
+        {
+        }
+        ~rollback_t()
+        {
+            if (done)
+                return;
+            iov.headers.resize(headers_length);
+            iov.parts.resize(parts_count);
+            if (!iov.parts.empty())
+                iov.parts.back().length = last_length;
+            iov.total = total;
+        }
+    } rollback(*this);
+
+    put_object(obj);
+    rollback.done = true;
+    return this;
+}
+
+/*
+ * sexp_iovec_t::segments()
+ * Returns segments of the image in output order.  Generated segments point into
+ * the internal buffer and are valid until the next call to add() or clear().
+ */
+std::vector<sexp_iovec_t::segment_t> sexp_iovec_t::segments(void) const
+{
+    std::vector<segment_t> res;
+    res.reserve(parts.size());
+    for (const auto &part : parts)
+        res.push_back({part.data != nullptr ? part.data : headers.data() + part.offset,
+                       part.length});
+    return res;
+}
+
+/*
+ * sexp_iovec_t::str()
+ * Returns the image as a contiguous string (copies everything, mostly for tests).
+ */
+octet_string sexp_iovec_t::str(void) const
+{
+    octet_string res;
+    res.reserve(total);
+    for (const auto &seg : segments())
+        res.append(seg.data, seg.length);
+    return res;
+}
+
+#ifndef _WIN32
+/*
+ * sexp_iovec_t::writev(fd)
+ * Writes the image to the file descriptor fd, which is expected to be blocking.
+ * Partial writes and interrupted calls are continued, other errors are reported
+ * with sexp_error.
+ */
+size_t sexp_iovec_t::writev(int fd) const
+{
+    std::vector<struct iovec> iov;
+    iov.reserve(parts.size());
+    for (const auto &seg : segments())
+        iov.push_back({const_cast<octet_t *>(seg.data), seg.length});
+
+    size_t written = 0;
+    size_t idx = 0;
+    while (idx < iov.size()) {
+        int     cnt = (int) std::min(iov.size() - idx, (size_t) IOV_MAX);
+        ssize_t res = ::writev(fd, &iov[idx], cnt);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            sexp_error(sexp_exception_t::error, "writev failed with error %zu", errno, EOF);
+            break;
+        }
+        written += res;
+        size_t left = res;
+        while (idx < iov.size() && left >= iov[idx].iov_len)
+            left -= iov[idx++].iov_len;
+        if (left > 0) {
+            iov[idx].iov_base = static_cast<octet_t *>(iov[idx].iov_base) + left;
+            iov[idx].iov_len -= left;
+        }
+    }
+    return written;
+}
+#endif
+
+} // namespace sexp
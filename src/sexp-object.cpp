@@ -26,10 +26,24 @@
  * 5/5/1997
  */
 
+#include <typeinfo>
+#include <unordered_map>
+
 #include "sexpp/sexp.h"
+#include "sexpp/sexp-visitor.h"
 
 namespace sexp {
 
+/*
+ * sexp_presentation_hint_t::none()
+ * Empty hint shared by all strings without a hint
+ */
+const sexp_simple_string_t &sexp_presentation_hint_t::none(void) noexcept
+{
+    static const sexp_simple_string_t empty;
+    return empty;
+}
+
 /*
  * sexp_string_t::parse(sis)
  * Parses the strin from input stream
@@ -51,9 +65,9 @@ void sexp_string_t::parse(sexp_input_stream_t *sis)
  */
 sexp_output_stream_t *sexp_string_t::print_canonical(sexp_output_stream_t *os) const
 {
-    if (with_presentation_hint) {
+    if (presentation_hint.has_value()) {
         os->var_put_char('[');
-        presentation_hint.print_canonical_verbatim(os);
+        presentation_hint.get().print_canonical_verbatim(os);
         os->var_put_char(']');
     }
     data_string.print_canonical_verbatim(os);
@@ -67,9 +81,9 @@ sexp_output_stream_t *sexp_string_t::print_canonical(sexp_output_stream_t *os) c
 sexp_output_stream_t *sexp_string_t::print_advanced(sexp_output_stream_t *os) const
 {
     sexp_object_t::print_advanced(os);
-    if (with_presentation_hint) {
+    if (presentation_hint.has_value()) {
         os->put_char('[');
-        presentation_hint.print_advanced(os);
+        presentation_hint.get().print_advanced(os);
         os->put_char(']');
     }
     data_string.print_advanced(os);
@@ -83,8 +97,8 @@ sexp_output_stream_t *sexp_string_t::print_advanced(sexp_output_stream_t *os) co
 size_t sexp_string_t::advanced_length(sexp_output_stream_t *os) const
 {
     size_t len = 0;
-    if (with_presentation_hint)
-        len += 2 + presentation_hint.advanced_length(os);
+    if (presentation_hint.has_value())
+        len += 2 + presentation_hint.get().advanced_length(os);
     len += data_string.advanced_length(os);
     return len;
 }
@@ -96,6 +110,8 @@ size_t sexp_string_t::advanced_length(sexp_output_stream_t *os) const
 
 void sexp_list_t::parse(sexp_input_stream_t *sis)
 {
+    if (sis->get_list_segment_size() != 0)
+        set_segment_size(sis->get_list_segment_size());
     sis->open_list()->skip_white_space();
     if (sis->get_next_char() == ')') {
         ;
@@ -115,50 +131,324 @@ void sexp_list_t::parse(sexp_input_stream_t *sis)
     }
 }
 
+namespace {
+
+/*
+ * is_derived(obj)
+ * Strings and lists are printed and measured without virtual calls.  Objects of
+ * classes derived from them carry the same kind tag but may override the printers,
+ * so they are handed over to their virtual functions.
+ */
+bool is_derived(const sexp_object_t &obj)
+{
+    return typeid(obj) != typeid(sexp_string_t) && typeid(obj) != typeid(sexp_list_t);
+}
+
+/*
+ * canonical_printer_t
+ * Prints out a tree in canonical form; strings are printed by a direct call.
+ */
+class canonical_printer_t : public sexp_visitor_t<canonical_printer_t> {
+    sexp_output_stream_t *os;
+    const sexp_list_t *   root;      /* printed here even if derived, see print_canonical */
+    const sexp_list_t *   delegated; /* derived list printed by its own print_canonical */
+
+  public:
+    canonical_printer_t(sexp_output_stream_t *o, const sexp_list_t &r)
+        : os(o), root(&r), delegated(nullptr)
+    {
+    }
+
+    action_t visit_string(const sexp_string_t &str)
+    {
+        if (is_derived(str))
+            str.print_canonical(os);
+        else
+            str.sexp_string_t::print_canonical(os);
+        return proceed;
+    }
+    action_t enter_list(const sexp_list_t &list)
+    {
+        if (&list != root && is_derived(list)) {
+            list.print_canonical(os);
+            delegated = &list;
+            return skip;
+        }
+        os->var_open_list();
+        return proceed;
+    }
+    action_t leave_list(const sexp_list_t &list)
+    {
+        if (&list == delegated)
+            delegated = nullptr;
+        else
+            os->var_close_list();
+        return proceed;
+    }
+    action_t visit_other(const sexp_object_t &obj)
+    {
+        obj.print_canonical(os);
+        return proceed;
+    }
+};
+
+/*
+ * advanced_length_counter_t
+ * Sums up advanced_length of the nodes of a tree.
+ */
+class advanced_length_counter_t : public sexp_visitor_t<advanced_length_counter_t> {
+    sexp_output_stream_t *os;
+    const sexp_list_t *   root;
+    const sexp_list_t *   delegated;
+
+  public:
+    size_t length;
+
+    advanced_length_counter_t(sexp_output_stream_t *o, const sexp_list_t &r)
+        : os(o), root(&r), delegated(nullptr), length(0)
+    {
+    }
+
+    action_t visit_string(const sexp_string_t &str)
+    {
+        length += is_derived(str) ? str.advanced_length(os) :
+                                    str.sexp_string_t::advanced_length(os);
+        return proceed;
+    }
+    action_t enter_list(const sexp_list_t &list)
+    {
+        if (&list != root && is_derived(list)) {
+            length += list.advanced_length(os);
+            delegated = &list;
+            return skip;
+        }
+        length++; /* for left paren */
+        return proceed;
+    }
+    action_t leave_list(const sexp_list_t &list)
+    {
+        if (&list == delegated)
+            delegated = nullptr;
+        else
+            length++; /* for right paren */
+        return proceed;
+    }
+    action_t visit_other(const sexp_object_t &obj)
+    {
+        length += obj.advanced_length(os);
+        return proceed;
+    }
+};
+
+} // namespace
+
 /*
  * sexp_list_t::print_canonical(os)
  * Prints out the list "list" onto output stream os
  */
 sexp_output_stream_t *sexp_list_t::print_canonical(sexp_output_stream_t *os) const
 {
-    os->var_open_list();
-    std::for_each(begin(), end(), [os](const std::shared_ptr<sexp_object_t> &obj) {
-        obj->print_canonical(os);
-    });
-    os->var_close_list();
+    canonical_printer_t(os, *this).traverse(*this);
     return os;
 }
 
+namespace {
+
 /*
- * sexp_list_t::print_advanced(os)
- * Prints out the list onto output stream os.
- * Uses print-length to determine length of the image.  If it all fits
- * on the current line, then it is printed that way.  Otherwise, it is
- * written out in "vertical" mode, with items of the list starting in
- * the same column on successive lines.
+ * advanced_extent_t
+ * Flat (single line) width of a list image, collected once per print_advanced call.
+ * advanced_length of an atom depends on the column the enclosing list starts at: a
+ * token that does not fit into the line is measured as a quoted string, which is two
+ * characters longer.  So besides the width with all tokens fitting we keep the number
+ * of such token atoms and the longest of them, which is enough to decide if the list
+ * fits at any column.
  */
-sexp_output_stream_t *sexp_list_t::print_advanced(sexp_output_stream_t *os) const
+struct advanced_extent_t {
+    size_t width;     /* advanced_length if all token atoms fit into the line */
+    size_t tokens;    /* number of atoms that can be printed as tokens */
+    size_t max_token; /* length of the longest of them */
+
+    advanced_extent_t(void) : width(0), tokens(0), max_token(0) {}
+
+    void add(const advanced_extent_t &e)
+    {
+        width += e.width;
+        tokens += e.tokens;
+        max_token = std::max(max_token, e.max_token);
+    }
+
+    void add(const sexp_simple_string_t &ss, const sexp_output_stream_t *os)
+    {
+        if (ss.can_print_as_token()) {
+            width += ss.advanced_length_token();
+            tokens++;
+            max_token = std::max(max_token, ss.length());
+        } else if (ss.can_print_as_quoted_string())
+            width += ss.advanced_length_quoted();
+        else if (ss.length() <= 4 && os->get_byte_size() == 8)
+            width += ss.advanced_length_hexadecimal();
+        else if (os->get_byte_size() == 8)
+            width += ss.advanced_length_base64();
+    }
+
+    /* Same as advanced_length(os) > os->get_max_column() - os->get_column() */
+    bool exceeds(uint32_t column, uint32_t max_column) const
+    {
+        uint32_t room = max_column - column;
+        if (max_column == 0)
+            return width > room;
+        if (column >= max_column)
+            return width + 2 * tokens > room;
+        /* A token that does not fit makes the list longer than the room alone */
+        return max_token >= room || width > room;
+    }
+};
+
+using advanced_extents_t = std::vector<advanced_extent_t>;
+
+/* Kind tags tell lists and strings apart without virtual calls */
+const sexp_list_t *list_view(const sexp_object_t &obj)
 {
-    sexp_object_t::print_advanced(os);
-    int vertical = false;
-    int firstelement = true;
+    return obj.get_kind() == sexp_object_t::list_kind ? static_cast<const sexp_list_t *>(&obj) :
+                                                        nullptr;
+}
+
+/*
+ * advanced_measure_t
+ * Bottom-up pass: computes the extent of every list in the tree and stores it in
+ * extents in pre-order.  The extents of the lists being walked are kept on a stack
+ * together with their positions in extents.
+ */
+class advanced_measure_t : public sexp_visitor_t<advanced_measure_t> {
+    const sexp_output_stream_t *                      os;
+    advanced_extents_t &                              extents;
+    std::vector<std::pair<size_t, advanced_extent_t>> open;
+    const sexp_list_t *                               root;
+    const sexp_list_t *                               delegated;
+
+    void add(const advanced_extent_t &extent)
+    {
+        if (!open.empty())
+            open.back().second.add(extent);
+    }
+    /* Width of an object measured by its own advanced_length */
+    void add_virtual(const sexp_object_t &obj)
+    {
+        advanced_extent_t extent;
+        extent.width = obj.advanced_length(const_cast<sexp_output_stream_t *>(os));
+        add(extent);
+    }
+
+  public:
+    advanced_measure_t(const sexp_output_stream_t *o,
+                       advanced_extents_t &        e,
+                       const sexp_list_t &         r)
+        : os(o), extents(e), root(&r), delegated(nullptr)
+    {
+    }
+
+    action_t visit_string(const sexp_string_t &str)
+    {
+        if (is_derived(str)) {
+            add_virtual(str);
+            return proceed;
+        }
+        advanced_extent_t extent;
+        if (str.has_presentation_hint()) {
+            extent.width += 2;
+            extent.add(str.get_presentation_hint(), os);
+        }
+        extent.add(str.get_string(), os);
+        add(extent);
+        return proceed;
+    }
+    action_t enter_list(const sexp_list_t &list)
+    {
+        if (&list != root && is_derived(list)) {
+            add_virtual(list);
+            delegated = &list;
+            return skip;
+        }
+        open.emplace_back(extents.size(), advanced_extent_t());
+        open.back().second.width = 2; /* for parens */
+        extents.emplace_back();
+        return proceed;
+    }
+    action_t leave_list(const sexp_list_t &list)
+    {
+        if (&list == delegated) {
+            delegated = nullptr;
+            return proceed;
+        }
+        extents[open.back().first] = open.back().second;
+        advanced_extent_t extent = open.back().second;
+        open.pop_back();
+        add(extent);
+        return proceed;
+    }
+    action_t visit_other(const sexp_object_t &obj)
+    {
+        add_virtual(obj);
+        return proceed;
+    }
+};
+
+/*
+ * print_advanced_list(list, os, extents, pos)
+ * Top-down pass: prints out the list using extents computed by measure_advanced.
+ * pos is the pre-order index of the list and is advanced past its subtree.
+ */
+void print_advanced_list(const sexp_list_t &      list,
+                         sexp_output_stream_t *   os,
+                         const advanced_extents_t &extents,
+                         size_t &                 pos)
+{
+    const advanced_extent_t &extent = extents[pos++];
+    bool                     firstelement = true;
+
+    list.sexp_object_t::print_advanced(os);
     os->open_list()->inc_indent();
-    vertical = (advanced_length(os) > os->get_max_column() - os->get_column());
+    bool vertical = extent.exceeds(os->get_column(), os->get_max_column());
 
-    std::for_each(begin(), end(), [&](const std::shared_ptr<sexp_object_t> &obj) {
+    for (const auto &child : list) {
         if (!firstelement) {
             if (vertical)
                 os->new_line(sexp_output_stream_t::advanced);
             else
                 os->put_char(' ');
         }
-        obj->print_advanced(os);
+        const sexp_list_t *sublist = list_view(*child);
+        if (sublist != nullptr && !is_derived(*sublist))
+            print_advanced_list(*sublist, os, extents, pos);
+        else
+            child->print_advanced(os);
         firstelement = false;
-    });
+    }
 
     if (os->get_max_column() > 0 && os->get_column() > os->get_max_column() - 2)
         os->new_line(sexp_output_stream_t::advanced);
-    return os->dec_indent()->put_char(')');
+    os->dec_indent()->close_list();
+}
+
+} // namespace
+
+/*
+ * sexp_list_t::print_advanced(os)
+ * Prints out the list onto output stream os.
+ * Uses print-length to determine length of the image.  If it all fits
+ * on the current line, then it is printed that way.  Otherwise, it is
+ * written out in "vertical" mode, with items of the list starting in
+ * the same column on successive lines.
+ * Lengths of all nested lists are computed once, before anything is printed,
+ * so the cost is linear in the size of the tree rather than in size times depth.
+ */
+sexp_output_stream_t *sexp_list_t::print_advanced(sexp_output_stream_t *os) const
+{
+    advanced_extents_t extents;
+    size_t             pos = 0;
+    advanced_measure_t(os, extents, *this).traverse(*this);
+    print_advanced_list(*this, os, extents, pos);
+    return os;
 }
 
 /*
@@ -167,11 +457,117 @@ sexp_output_stream_t *sexp_list_t::print_advanced(sexp_output_stream_t *os) cons
  */
 size_t sexp_list_t::advanced_length(sexp_output_stream_t *os) const
 {
-    size_t len = 1; /* for left paren */
-    std::for_each(begin(), end(), [&](const std::shared_ptr<sexp_object_t> &obj) {
-        len += obj->advanced_length(os);
-    });
-    return (len + 1); /* for final paren */
+    advanced_length_counter_t counter(os, *this);
+    counter.traverse(*this);
+    return counter.length;
+}
+
+const sexp_list_t::size_type sexp_list_t::TOKEN_INDEX_THRESHOLD;
+
+struct sexp_list_t::token_index_t {
+    uint32_t                                version; /* of the list the index is built for */
+    std::unordered_map<std::string, size_type> positions;
+
+    token_index_t(uint32_t v) : version(v) {}
+};
+
+/*
+ * sexp_list_t::token_index_ptr_t::install(expected, index)
+ * Replaces expected by index, unless another thread has installed an index meanwhile.
+ * Returns the installed index.
+ */
+sexp_list_t::token_index_t *sexp_list_t::token_index_ptr_t::install(
+  token_index_t *expected, token_index_t *index) noexcept
+{
+    if (ptr.compare_exchange_strong(expected, index, std::memory_order_acq_rel)) {
+        delete expected;
+        return index;
+    }
+    delete index;
+    return expected;
+}
+
+void sexp_list_t::token_index_ptr_t::reset(token_index_t *index) noexcept
+{
+    delete ptr.exchange(index, std::memory_order_acq_rel);
+}
+
+namespace {
+
+/* Returns the leading string of obj if obj is a non-empty list that starts with one */
+const sexp_simple_string_t *leading_token(const sexp_object_t &obj)
+{
+    const sexp_list_t *list = list_view(obj);
+    return list != nullptr ? list->sexp_simple_string_at(0) : nullptr;
+}
+
+} // namespace
+
+/*
+ * sexp_list_t::get_token_index()
+ * Returns the index of child lists by their leading tokens, builds it if there is
+ * none or the list has been changed since it was built.  Concurrent readers may
+ * build it at the same time, one of the copies is kept.
+ */
+const sexp_list_t::token_index_t *sexp_list_t::get_token_index(void) const
+{
+    token_index_t *index = token_index.get();
+    if (index != nullptr && index->version == version())
+        return index;
+
+    std::unique_ptr<token_index_t> fresh(new token_index_t(version()));
+    for (size_type i = 0; i < size(); i++) {
+        const sexp_simple_string_t *token = leading_token(*(*this)[i]);
+        if (token != nullptr)
+            fresh->positions.emplace(
+              std::string(reinterpret_cast<const char *>(token->data()), token->length()), i);
+    }
+    return token_index.install(index, fresh.release());
+}
+
+/*
+ * sexp_list_t::find_token(name, length)
+ * Short lists are scanned, longer ones are looked up in an index that is built on
+ * first use and rebuilt after the list is modified.  Modification of the leading
+ * string of a child in place is not tracked, the list's element shall be replaced
+ * with replace() instead.
+ */
+const sexp_list_t *sexp_list_t::find_token(const octet_t *name, size_t length) const
+{
+    if (size() < TOKEN_INDEX_THRESHOLD) {
+        for (const auto &child : *this) {
+            const sexp_simple_string_t *token = leading_token(*child);
+            if (token != nullptr && token->length() == length &&
+                octet_traits::compare(token->data(), name, length) == 0)
+                return list_view(*child);
+        }
+        return nullptr;
+    }
+
+    const token_index_t *index = get_token_index();
+    auto it = index->positions.find(std::string(reinterpret_cast<const char *>(name), length));
+    return it != index->positions.end() ? list_view(*(*this)[it->second]) : nullptr;
+}
+
+/*
+ * sexp_list_t::unshare(pos)
+ * The copy is shallow: elements of a copied list stay shared until they are unshared
+ * in turn.  Objects of derived classes cannot be copied without slicing them.
+ */
+const std::shared_ptr<sexp_object_t> &sexp_list_t::unshare(size_type pos)
+{
+    const std::shared_ptr<sexp_object_t> &obj = at(pos);
+    if (!obj || !obj->is_shared())
+        return obj;
+    check_unshared();
+    if (is_derived(*obj))
+        sexp_error(
+          sexp_exception_t::error, "Shared object of a derived class cannot be copied", EOF);
+    if (obj->is_sexp_string())
+        replace(pos, std::make_shared<sexp_string_t>(static_cast<const sexp_string_t &>(*obj)));
+    else
+        replace(pos, std::make_shared<sexp_list_t>(static_cast<const sexp_list_t &>(*obj)));
+    return at(pos);
 }
 
 /*
@@ -185,4 +581,4 @@ sexp_output_stream_t *sexp_object_t::print_advanced(sexp_output_stream_t *os) co
     return os;
 }
 
-} // namespace sexp
\ No newline at end of file
+} // namespace sexp
@@ -43,13 +43,23 @@ sexp_output_stream_t::sexp_output_stream_t(std::ostream *o, size_t m_depth)
     set_output(o, m_depth);
 }
 
+sexp_output_stream_t::sexp_output_stream_t(sexp_byte_sink_t *s, size_t m_depth)
+{
+    set_output(s, m_depth);
+}
+
 /*
  * sexp_output_stream_t::set_output
  * Re-initializes new sexp_output_stream_t object.
  */
 sexp_output_stream_t *sexp_output_stream_t::set_output(std::ostream *o, size_t m_depth)
 {
-    output_file = o;
+    return set_output(ostream_sink.set_output(o), m_depth);
+}
+
+sexp_output_stream_t *sexp_output_stream_t::set_output(sexp_byte_sink_t *s, size_t m_depth)
+{
+    output_sink = s;
     byte_size = 8;
     bits = 0;
     n_bits = 0;
@@ -69,7 +79,7 @@ sexp_output_stream_t *sexp_output_stream_t::set_output(std::ostream *o, size_t m
  */
 sexp_output_stream_t *sexp_output_stream_t::put_char(int c)
 {
-    output_file->put(c);
+    output_sink->put((octet_t) c);
     column++;
     return this;
 }
@@ -101,6 +111,24 @@ sexp_output_stream_t *sexp_output_stream_t::var_put_char(int c)
     return this;
 }
 
+/*
+ * sexp_output_stream_t::var_put_chars(bt, ln)
+ * Same as var_put_char for each of ln characters at bt.  When no encoding or line
+ * breaking may happen, characters are written as one block.
+ */
+sexp_output_stream_t *sexp_output_stream_t::var_put_chars(const octet_t *bt, size_t ln)
+{
+    if (byte_size == 8 && n_bits == 0 && (mode == canonical || max_column == 0)) {
+        output_sink->write(bt, ln);
+        column += ln;
+        base64_count += ln;
+        return this;
+    }
+    for (size_t i = 0; i < ln; i++)
+        var_put_char(bt[i]);
+    return this;
+}
+
 /*
  * sexp_output_stream_t::change_output_byte_size(newByteSize,newMode)
  * Change os->byte_size to newByteSize
@@ -0,0 +1,188 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+#include "sexpp/sexp.h"
+
+namespace sexp {
+
+namespace {
+
+/*
+ * Children of a list are split into consecutive chunks.  Worker threads take chunks
+ * in order and encode them into their own buffers, the calling thread writes the
+ * buffers out in order as soon as each one is ready and releases it.  A worker does
+ * not start a chunk more than window chunks ahead of the last one written, so a slow
+ * output does not let encoded buffers pile up.
+ */
+struct parallel_job_t {
+    const sexp_list_t &                    list;
+    size_t                                 chunk_size;
+    size_t                                 max_depth;
+    std::vector<std::promise<std::string>> chunks;
+    std::atomic<size_t>                    next;
+    size_t                                 window;
+    size_t                                 released; /* chunks written out */
+    std::mutex                             lock;
+    std::condition_variable                writable;
+
+    parallel_job_t(const sexp_list_t &l, size_t n_chunks, size_t m_depth, size_t w)
+        : list(l), chunk_size((l.size() + n_chunks - 1) / n_chunks), max_depth(m_depth),
+          chunks((l.size() + chunk_size - 1) / chunk_size), next(0), window(w), released(0)
+    {
+    }
+
+    void release(void)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            released++;
+        }
+        writable.notify_all();
+    }
+
+    void encode(size_t idx)
+    {
+        try {
+            std::ostringstream   oss(std::ios_base::binary);
+            sexp_output_stream_t os(&oss, max_depth);
+            size_t               end = std::min(list.size(), (idx + 1) * chunk_size);
+            for (size_t i = idx * chunk_size; i < end; i++)
+                list[i]->print_canonical(&os);
+            chunks[idx].set_value(oss.str());
+        } catch (...) {
+            chunks[idx].set_exception(std::current_exception());
+        }
+    }
+
+    void work(void)
+    {
+        size_t idx;
+        while ((idx = next++) < chunks.size()) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                writable.wait(guard, [this, idx]() { return idx < released + window; });
+            }
+            encode(idx);
+        }
+    }
+};
+
+} // namespace
+
+/*
+ * sexp_output_stream_t::print_canonical_parallel(obj, threads)
+ * Prints out canonical image of the object, encoding children of a top-level list
+ * concurrently on the given number of threads (0 means number of CPU cores).
+ * The image is the same as print_canonical produces.  Small objects are printed
+ * by the calling thread only.
+ */
+sexp_output_stream_t *sexp_output_stream_t::print_canonical_parallel(
+  const std::shared_ptr<sexp_object_t> &obj, unsigned threads)
+{
+    /* no need to split lists with fewer children per thread */
+    static const size_t MIN_CHUNK = 64;
+
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    const sexp_list_t *list = obj->sexp_list_view();
+    if (threads == 1 || list == nullptr || list->size() < 2 * MIN_CHUNK)
+        return print_canonical(obj);
+    size_t m_depth = get_max_depth();
+    if (m_depth != 0 && get_depth() + 1 >= m_depth) {
+        /* the list itself exceeds maximum depth or its children have no room */
+        return print_canonical(obj);
+    }
+
+    /* a few chunks per thread to balance subtrees of different size */
+    size_t         n_chunks = std::min(list->size() / MIN_CHUNK, (size_t) threads * 8);
+    /* and two chunks per thread in flight */
+    parallel_job_t job(
+      *list, n_chunks, m_depth == 0 ? 0 : m_depth - get_depth() - 1, (size_t) threads * 2);
+    std::vector<std::future<std::string>> images;
+    for (auto &chunk : job.chunks)
+        images.push_back(chunk.get_future());
+
+    /* if a chunk fails, depth and pending bits are left as they were on entry */
+    struct state_guard_t {
+        sexp_output_stream_t *os;
+        depth_guard_t         depth;
+        uint32_t              bits;
+        uint32_t              n_bits;
+        bool                  done;
+
+        state_guard_t(sexp_output_stream_t *o)
+            : os(o), depth(*o), bits(o->bits), n_bits(o->n_bits), done(false)
+        {
+        }
+        ~state_guard_t()
+        {
+            if (done)
+                return;
+            os->bits = bits;
+            os->n_bits = n_bits;
+        }
+    } guard(this);
+
+    var_open_list();
+    std::vector<std::thread> workers;
+    try {
+        for (unsigned i = 0; i < threads; i++)
+            workers.emplace_back(&parallel_job_t::work, &job);
+    } catch (const std::system_error &) {
+        /* could not start (all) threads, do the rest of the work here */
+        if (workers.empty()) {
+            job.window = job.chunks.size();
+            job.work();
+        }
+    }
+
+    std::exception_ptr error;
+    for (auto &image : images) {
+        try {
+            std::string str = image.get();
+            if (!error)
+                var_put_chars(reinterpret_cast<const octet_t *>(str.data()), str.size());
+        } catch (...) {
+            if (!error)
+                error = std::current_exception();
+        }
+        job.release();
+    }
+    for (auto &worker : workers)
+        worker.join();
+    if (error)
+        std::rethrow_exception(error);
+    var_close_list();
+    guard.done = true;
+    return this;
+}
+
+} // namespace sexp
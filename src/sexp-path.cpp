@@ -0,0 +1,330 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexpp/sexp-path.h"
+
+namespace sexp {
+
+const size_t sexp_path_t::MAX_STEPS;
+
+namespace {
+
+const sexp_list_t *list_view(const sexp_object_t &obj)
+{
+    return const_cast<sexp_object_t &>(obj).sexp_list_view();
+}
+
+/*
+ * canonical_reader_t
+ * Walks a canonical image element by element.
+ */
+class canonical_reader_t {
+    const octet_t *bt;
+    size_t         ln;
+    size_t         pos;
+
+    size_t scan_length(void)
+    {
+        size_t length = 0;
+        size_t start = pos;
+        while (pos < ln && bt[pos] >= '0' && bt[pos] <= '9') {
+            if (length > (std::numeric_limits<uint32_t>::max() - 9) / 10)
+                sexp_error(sexp_exception_t::error, "Decimal number is too long", start);
+            length = length * 10 + (bt[pos++] - '0');
+        }
+        if (pos == start)
+            sexp_error(
+              sexp_exception_t::error, "Unexpected character in canonical image", pos);
+        if (pos >= ln || bt[pos] != ':')
+            sexp_error(sexp_exception_t::error, "Character ':' is expected", pos);
+        pos++;
+        if (length > ln - pos)
+            sexp_error(sexp_exception_t::error, "Canonical image is truncated", ln);
+        return length;
+    }
+
+  public:
+    canonical_reader_t(const octet_t *b, size_t l) : bt(b), ln(l), pos(0) {}
+
+    size_t position(void) const noexcept { return pos; }
+    int    peek(void) const
+    {
+        if (pos >= ln)
+            sexp_error(sexp_exception_t::error, "Canonical image is truncated", ln);
+        return bt[pos];
+    }
+    void skip_char(void) { pos++; }
+    bool at_atom(void) const { return peek() == '[' || (peek() >= '0' && peek() <= '9'); }
+
+    /* Reads [hint]string, returns the string */
+    sexp_path_t::span_t read_atom(void)
+    {
+        if (peek() == '[') {
+            pos++;
+            pos += scan_length();
+            if (peek() != ']')
+                sexp_error(sexp_exception_t::error, "Character ']' is expected", pos);
+            pos++;
+        }
+        size_t length = scan_length();
+        pos += length;
+        return {bt + pos - length, length};
+    }
+
+    /* Skips elements up to and including the ')' that closes the current list */
+    void skip_list(void)
+    {
+        size_t depth = 1;
+        while (depth > 0) {
+            int c = peek();
+            if (c == '(') {
+                pos++;
+                depth++;
+            } else if (c == ')') {
+                pos++;
+                depth--;
+            } else
+                read_atom();
+        }
+    }
+};
+
+} // namespace
+
+/*
+ * sexp_path_t::sexp_path_t(p)
+ * Compiles path p.
+ */
+sexp_path_t::sexp_path_t(const std::string &p) : path(p)
+{
+    size_t pos = 0;
+    bool   descendant = false;
+    if (path.compare(0, 2, "//") == 0) {
+        descendant = true;
+        pos = 2;
+    } else if (path.compare(0, 1, "/") == 0)
+        pos = 1;
+
+    while (true) {
+        size_t end = path.find('/', pos);
+        if (end == std::string::npos)
+            end = path.length();
+        if (end == pos)
+            sexp_error(sexp_exception_t::error, "Empty step in path", pos);
+        std::string token = path.substr(pos, end - pos);
+        steps.push_back({token, token == "*", descendant});
+        if (steps.size() > MAX_STEPS)
+            sexp_error(sexp_exception_t::error, "Path has too many steps", pos);
+        if (end == path.length())
+            break;
+        descendant = path.compare(end, 2, "//") == 0;
+        pos = end + (descendant ? 2 : 1);
+    }
+}
+
+/*
+ * sexp_path_t::advance(active, token, length, matched)
+ * Steps are states of an automaton, bit i of active is set if step i may match the
+ * next list.  Returns the states for children of a list that starts with token
+ * (nullptr if it does not start with a string), sets matched if the list matches the
+ * whole path.
+ */
+uint64_t sexp_path_t::advance(uint64_t       active,
+                              const octet_t *token,
+                              size_t         length,
+                              bool &         matched) const
+{
+    uint64_t next = 0;
+    matched = false;
+    for (size_t i = 0; active != 0; i++, active >>= 1) {
+        if (!(active & 1))
+            continue;
+        const step_t &step = steps[i];
+        if (step.descendant)
+            next |= uint64_t(1) << i;
+        if (!step.any && (token == nullptr || step.token.length() != length ||
+                          memcmp(step.token.data(), token, length) != 0))
+            continue;
+        if (i + 1 == steps.size())
+            matched = true;
+        else
+            next |= uint64_t(1) << (i + 1);
+    }
+    return next;
+}
+
+/*
+ * sexp_path_t::search(list, active, all, first)
+ * Matches list and its descendants; collects matches to all, or stops at the first
+ * one, stored to first.  Returns true when stopped.
+ */
+bool sexp_path_t::search(const sexp_list_t &                list,
+                         uint64_t                           active,
+                         std::vector<const sexp_list_t *> *all,
+                         const sexp_list_t **               first) const
+{
+    const sexp_simple_string_t *token = list.sexp_simple_string_at(0);
+    bool                        matched;
+    uint64_t next = advance(active, token ? token->data() : nullptr, token ? token->length() : 0,
+                            matched);
+    if (matched) {
+        if (all == nullptr) {
+            *first = &list;
+            return true;
+        }
+        all->push_back(&list);
+    }
+    if (next == 0)
+        return false;
+
+    size_t from = 0;
+    /* a single named step: the first candidate is looked up through the index, the
+     * rest is scanned only if it fails */
+    if (all == nullptr && (next & (next - 1)) == 0) {
+        size_t        i = 0;
+        const step_t *step;
+        while (!(next & (uint64_t(1) << i)))
+            i++;
+        step = &steps[i];
+        if (!step->any && !step->descendant) {
+            const sexp_list_t *candidate = list.find_token(step->token);
+            if (candidate == nullptr)
+                return false;
+            if (search(*candidate, next, all, first))
+                return true;
+            while (list_view(*list[from]) != candidate)
+                from++;
+            from++;
+        }
+    }
+    for (size_t i = from; i < list.size(); i++) {
+        const sexp_list_t *child = list_view(*list[i]);
+        if (child != nullptr && search(*child, next, all, first))
+            return true;
+    }
+    return false;
+}
+
+/*
+ * sexp_path_t::find(root)
+ */
+const sexp_list_t *sexp_path_t::find(const sexp_object_t &root) const
+{
+    const sexp_list_t *list = list_view(root);
+    const sexp_list_t *res = nullptr;
+    if (list != nullptr)
+        search(*list, 1, nullptr, &res);
+    return res;
+}
+
+/*
+ * sexp_path_t::find_all(root)
+ */
+std::vector<const sexp_list_t *> sexp_path_t::find_all(const sexp_object_t &root) const
+{
+    std::vector<const sexp_list_t *> res;
+    const sexp_list_t *              list = list_view(root);
+    if (list != nullptr)
+        search(*list, 1, &res, nullptr);
+    return res;
+}
+
+/*
+ * sexp_path_t::value(root)
+ */
+const sexp_simple_string_t *sexp_path_t::value(const sexp_object_t &root) const
+{
+    const sexp_list_t *list = find(root);
+    return list != nullptr ? list->sexp_simple_string_at(1) : nullptr;
+}
+
+/*
+ * sexp_path_t::find(bt, ln, list)
+ * Runs the same automaton over the image without building a tree.  Lists that
+ * cannot contain a match are skipped, atoms are skipped by their length prefixes.
+ */
+bool sexp_path_t::find(const octet_t *bt, size_t ln, span_t &list) const
+{
+    canonical_reader_t    reader(bt, ln);
+    std::vector<uint64_t> stack; /* states for children of the open lists */
+    uint64_t              active = 1;
+
+    do {
+        if (reader.at_atom()) {
+            reader.read_atom();
+            continue;
+        }
+        if (reader.peek() == ')') {
+            if (stack.empty())
+                sexp_error(sexp_exception_t::error, "Unexpected character ')'", reader.position());
+            reader.skip_char();
+            active = stack.back();
+            stack.pop_back();
+            continue;
+        }
+        if (reader.peek() != '(')
+            sexp_error(sexp_exception_t::error, "Unexpected character in canonical image",
+                       reader.position());
+
+        size_t start = reader.position();
+        span_t token = {nullptr, 0};
+        bool   matched;
+        reader.skip_char();
+        if (reader.at_atom())
+            token = reader.read_atom();
+        uint64_t next = advance(active, token.data, token.length, matched);
+        if (matched) {
+            reader.skip_list();
+            list = {bt + start, reader.position() - start};
+            return true;
+        }
+        if (next == 0) {
+            reader.skip_list();
+            continue;
+        }
+        stack.push_back(active);
+        active = next;
+    } while (!stack.empty());
+    return false;
+}
+
+/*
+ * sexp_path_t::value(bt, ln, atom)
+ */
+bool sexp_path_t::value(const octet_t *bt, size_t ln, span_t &atom) const
+{
+    span_t list;
+    if (!find(bt, ln, list))
+        return false;
+    canonical_reader_t reader(list.data, list.length);
+    reader.skip_char();
+    if (!reader.at_atom())
+        return false;
+    reader.read_atom();
+    if (!reader.at_atom())
+        return false;
+    atom = reader.read_atom();
+    return true;
+}
+
+} // namespace sexp
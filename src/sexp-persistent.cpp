@@ -0,0 +1,162 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <typeinfo>
+
+#include "sexpp/sexp-persistent.h"
+
+namespace sexp {
+
+namespace {
+
+const sexp_list_t *list_view(const sexp_object_t *node)
+{
+    return node != nullptr && node->is_sexp_list() ? static_cast<const sexp_list_t *>(node) :
+                                                     nullptr;
+}
+
+bool leads_with(const sexp_object_t *node, const std::string &token)
+{
+    const sexp_list_t *list = list_view(node);
+    if (list == nullptr || list->empty())
+        return false;
+    const sexp_simple_string_t *ss = list->sexp_simple_string_at(0);
+    return ss != nullptr && ss->length() == token.length() &&
+           std::memcmp(ss->data(), token.data(), token.length()) == 0;
+}
+
+} // namespace
+
+/*
+ * sexp_persistent_t::update(node, path, depth, op, value)
+ * Returns a copy of the list node with the element at path[depth] updated; the
+ * element is updated recursively unless it is the last step.
+ */
+sexp_persistent_t::node_t sexp_persistent_t::update(const node_t &node,
+                                                    const path_t &path,
+                                                    size_t        depth,
+                                                    operation_t   op,
+                                                    const node_t &value)
+{
+    const sexp_list_t *list = list_view(node.get());
+    if (list == nullptr)
+        sexp_error(
+          sexp_exception_t::error, "Path step %zu does not lead to a list", depth, -1);
+
+    bool   last = depth + 1 == path.size();
+    size_t pos = path[depth];
+    if (pos > list->size() || (pos == list->size() && !(last && op == op_insert)))
+        sexp_error(sexp_exception_t::error, "Path step %zu is out of range", depth, -1);
+
+    /* a copy would be sliced and lose the overrides of the derived class */
+    if (typeid(*list) != typeid(sexp_list_t))
+        sexp_error(sexp_exception_t::error,
+                   "Path step %zu leads through a list of a derived class",
+                   depth,
+                   -1);
+
+    auto copy = std::make_shared<sexp_list_t>(*list);
+    if (!last)
+        copy->replace(pos,
+                      std::const_pointer_cast<sexp_object_t>(
+                        update((*list)[pos], path, depth + 1, op, value)));
+    else if (op == op_set)
+        copy->replace(pos, std::const_pointer_cast<sexp_object_t>(value));
+    else if (op == op_insert)
+        copy->insert(copy->begin() + pos, std::const_pointer_cast<sexp_object_t>(value));
+    else
+        copy->erase(copy->begin() + pos);
+    return copy;
+}
+
+/*
+ * sexp_persistent_t::at(path)
+ */
+sexp_persistent_t::node_t sexp_persistent_t::at(const path_t &path) const
+{
+    node_t node = root_node;
+    for (size_t pos : path) {
+        const sexp_list_t *list = list_view(node.get());
+        if (list == nullptr || pos >= list->size())
+            return nullptr;
+        node = (*list)[pos];
+    }
+    return node;
+}
+
+/*
+ * sexp_persistent_t::locate(tokens, path)
+ */
+bool sexp_persistent_t::locate(const std::vector<std::string> &tokens, path_t &path) const
+{
+    path.clear();
+    if (tokens.empty() || !leads_with(root_node.get(), tokens[0]))
+        return false;
+    const sexp_list_t *list = list_view(root_node.get());
+    for (size_t i = 1; i < tokens.size(); i++) {
+        size_t pos = 1;
+        while (pos < list->size() && !leads_with((*list)[pos].get(), tokens[i]))
+            pos++;
+        if (pos == list->size())
+            return false;
+        path.push_back(pos);
+        list = list_view((*list)[pos].get());
+    }
+    return true;
+}
+
+/*
+ * sexp_persistent_t::set(path, value)
+ */
+sexp_persistent_t sexp_persistent_t::set(const path_t &path, node_t value) const
+{
+    if (!value)
+        sexp_error(sexp_exception_t::error, "Null element", -1);
+    if (path.empty())
+        return sexp_persistent_t(std::move(value));
+    return sexp_persistent_t(update(root_node, path, 0, op_set, value));
+}
+
+/*
+ * sexp_persistent_t::insert(path, value)
+ */
+sexp_persistent_t sexp_persistent_t::insert(const path_t &path, node_t value) const
+{
+    if (!value)
+        sexp_error(sexp_exception_t::error, "Null element", -1);
+    if (path.empty())
+        sexp_error(sexp_exception_t::error, "Cannot insert at the root", -1);
+    return sexp_persistent_t(update(root_node, path, 0, op_insert, value));
+}
+
+/*
+ * sexp_persistent_t::erase(path)
+ */
+sexp_persistent_t sexp_persistent_t::erase(const path_t &path) const
+{
+    if (path.empty())
+        sexp_error(sexp_exception_t::error, "Cannot erase the root", -1);
+    return sexp_persistent_t(update(root_node, path, 0, op_erase, nullptr));
+}
+
+} // namespace sexp
@@ -151,38 +151,143 @@ sexp_output_stream_t *sexp_simple_string_t::print_advanced(sexp_output_stream_t
 }
 
 /*
- * sexp_simple_string_t::can_print_as_quoted_string(void)
+ * sexp_simple_string_t::classify(bt, ln)
+ * Scans ln octets at bt and returns their character classes.
+ */
+uint8_t sexp_simple_string_t::classify(const octet_t *bt, size_t ln)
+{
+    uint8_t cls = classified | token_safe | quote_safe;
+    if (ln <= 0)
+        cls &= ~token_safe;
+    else if (is_dec_digit((int) *bt))
+        cls = (cls | leading_digit) & ~token_safe;
+    for (size_t i = 0; i < ln; i++, bt++) {
+        if (!is_token_char((int) (*bt))) {
+            cls &= ~token_safe;
+            if (*bt != ' ') {
+                cls &= ~quote_safe;
+                break;
+            }
+        }
+    }
+    return cls;
+}
+
+/*
+ * sexp_simple_string_t::classify()
+ * Scans the string once and caches its character classes.
+ * Subsequent calls return cached value until the string is modified.
+ */
+uint8_t sexp_simple_string_t::classify(void) const
+{
+    uint8_t cls = classification.get();
+    if (cls & classified)
+        return cls;
+
+    cls = classify(c_str(), length());
+    classification.set(cls);
+    return cls;
+}
+
+/*
+ * sexp_simple_string_t::can_print_as_quoted_string()
  * Returns true if simple string can be printed as a quoted string.
  * Must have only tokenchars and blanks.
  */
 bool sexp_simple_string_t::can_print_as_quoted_string(void) const
 {
-    const octet_t *c = c_str();
-    for (uint32_t i = 0; i < length(); i++, c++) {
-        if (!is_token_char((int) (*c)) && *c != ' ')
-            return false;
-    }
-    return true;
+    return (classify() & quote_safe) != 0;
 }
 
 /*
- * sexp_simple_string_t::can_print_as_token(os)
- * Returns true if simple string can be printed as a token.
+ * sexp_simple_string_t::can_print_as_token()
+ * Returns true if simple string can be printed as a token regardless of line width.
  * Doesn't begin with a digit, and all characters are tokenchars.
  */
+bool sexp_simple_string_t::can_print_as_token(void) const
+{
+    return (classify() & token_safe) != 0;
+}
+
+/*
+ * sexp_simple_string_t::can_print_as_token(os)
+ * Returns true if simple string can be printed as a token at the current column of os.
+ */
 bool sexp_simple_string_t::can_print_as_token(const sexp_output_stream_t *os) const
 {
-    const octet_t *c = c_str();
-    if (length() <= 0)
-        return false;
-    if (is_dec_digit((int) *c))
-        return false;
     if (os->get_max_column() > 0 && os->get_column() + length() >= os->get_max_column())
         return false;
-    for (uint32_t i = 0; i < length(); i++) {
-        if (!is_token_char((int) (*c++)))
+    return can_print_as_token();
+}
+
+/*
+ * sexp_simple_string_t::can_print_as_quoted_string(bt, ln)
+ * Same as can_print_as_quoted_string() for ln octets at bt.
+ */
+bool sexp_simple_string_t::can_print_as_quoted_string(const octet_t *bt, size_t ln)
+{
+    return (classify(bt, ln) & quote_safe) != 0;
+}
+
+/*
+ * sexp_simple_string_t::can_print_as_token(bt, ln)
+ * Same as can_print_as_token() for ln octets at bt.
+ */
+bool sexp_simple_string_t::can_print_as_token(const octet_t *bt, size_t ln)
+{
+    return (classify(bt, ln) & token_safe) != 0;
+}
+
+/*
+ * sexp_simple_string_t::to_limbs(limbs, count)
+ * Converts the big-endian magnitude into little-endian 64-bit limbs, reading eight
+ * octets per limb from the least significant end.
+ */
+size_t sexp_simple_string_t::to_limbs(uint64_t *limbs, size_t count) const noexcept
+{
+    span_t mag = magnitude();
+    size_t needed = (mag.length + 7) / 8;
+    if (needed > count)
+        return needed;
+    const octet_t *end = mag.data + mag.length;
+    size_t         i = 0;
+    for (; end - mag.data >= 8; i++, end -= 8)
+        limbs[i] = (uint64_t) end[-8] << 56 | (uint64_t) end[-7] << 48 |
+                   (uint64_t) end[-6] << 40 | (uint64_t) end[-5] << 32 |
+                   (uint64_t) end[-4] << 24 | (uint64_t) end[-3] << 16 |
+                   (uint64_t) end[-2] << 8 | (uint64_t) end[-1];
+    if (end > mag.data) {
+        uint64_t limb = 0;
+        for (const octet_t *bt = mag.data; bt < end; bt++)
+            limb = (limb << 8) | *bt;
+        limbs[i++] = limb;
+    }
+    for (; i < count; i++)
+        limbs[i] = 0;
+    return needed;
+}
+
+/*
+ * sexp_simple_string_t::to_uint64(value)
+ * Parses decimal digits with overflow checks; unlike as_unsigned() rejects signs,
+ * blanks and trailing garbage instead of stopping at them.
+ */
+bool sexp_simple_string_t::to_uint64(uint64_t &value) const noexcept
+{
+    if (empty())
+        return false;
+    const uint64_t max = std::numeric_limits<uint64_t>::max();
+    uint64_t       v = 0;
+    for (octet_t c : *this) {
+        // not is_dec_digit(): it goes through the locale for every character
+        if (c < '0' || c > '9')
+            return false;
+        unsigned digit = c - '0';
+        if (v > (max - digit) / 10)
             return false;
+        v = v * 10 + digit;
     }
+    value = v;
     return true;
 }
 
@@ -0,0 +1,192 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexpp/sexp-writer.h"
+
+namespace sexp {
+
+/*
+ * sexp_writer_t::sexp_writer_t
+ * Creates a writer that emits S-expressions to output stream o in print mode m.
+ */
+sexp_writer_t::sexp_writer_t(sexp_output_stream_t *o, sexp_output_stream_t::sexp_print_mode m)
+    : output(o), mode(m), depth(0), need_space(false), saved_max_column(o->get_max_column())
+{
+    if (mode == sexp_output_stream_t::advanced)
+        output->set_max_column(0);
+}
+
+/*
+ * sexp_writer_t::~sexp_writer_t
+ * Gives the output stream back its max column.
+ */
+sexp_writer_t::~sexp_writer_t()
+{
+    output->set_max_column(saved_max_column);
+}
+
+/*
+ * sexp_writer_t::begin_element()
+ * Starts list or atom: opens base64 region for top-level object or puts separator
+ * between elements of a list in advanced mode.
+ */
+void sexp_writer_t::begin_element(void)
+{
+    if (depth == 0 && mode == sexp_output_stream_t::base64)
+        output->change_output_byte_size(8, sexp_output_stream_t::base64)
+          ->var_put_char('{')
+          ->change_output_byte_size(6, sexp_output_stream_t::base64);
+    if (need_space)
+        output->put_char(' ');
+}
+
+/*
+ * sexp_writer_t::end_element()
+ * Completes list or atom: closes base64 region after top-level object.
+ */
+void sexp_writer_t::end_element(void)
+{
+    if (depth == 0 && mode == sexp_output_stream_t::base64)
+        output->flush()->change_output_byte_size(8, sexp_output_stream_t::base64)->var_put_char(
+          '}');
+    need_space = depth > 0 && mode == sexp_output_stream_t::advanced;
+}
+
+/*
+ * sexp_writer_t::put_verbatim(bt, ln)
+ * Emits verbatim image of simple string, same as print_canonical_verbatim.
+ */
+void sexp_writer_t::put_verbatim(const octet_t *bt, size_t ln)
+{
+    output->print_decimal(ln)->var_put_char(':');
+    for (size_t i = 0; i < ln; i++)
+        output->var_put_char(bt[i]);
+}
+
+/*
+ * sexp_writer_t::put_advanced(bt, ln)
+ * Emits advanced image of simple string choosing the same representation as
+ * sexp_simple_string_t::print_advanced does with no line width limit.
+ */
+void sexp_writer_t::put_advanced(const octet_t *bt, size_t ln)
+{
+    if (sexp_simple_string_t::can_print_as_token(bt, ln)) {
+        for (size_t i = 0; i < ln; i++)
+            output->put_char(bt[i]);
+    } else if (sexp_simple_string_t::can_print_as_quoted_string(bt, ln)) {
+        output->put_char('\"');
+        for (size_t i = 0; i < ln; i++)
+            output->put_char(bt[i]);
+        output->put_char('\"');
+    } else if (ln <= 4) {
+        output->put_char('#')->change_output_byte_size(4, sexp_output_stream_t::advanced);
+        for (size_t i = 0; i < ln; i++)
+            output->var_put_char(bt[i]);
+        output->flush()->change_output_byte_size(8, sexp_output_stream_t::advanced)->put_char('#');
+    } else {
+        output->var_put_char('|')->change_output_byte_size(6, sexp_output_stream_t::advanced);
+        for (size_t i = 0; i < ln; i++)
+            output->var_put_char(bt[i]);
+        output->flush()->change_output_byte_size(8, sexp_output_stream_t::advanced)->var_put_char(
+          '|');
+    }
+}
+
+void sexp_writer_t::put_simple_string(const octet_t *bt, size_t ln)
+{
+    if (mode == sexp_output_stream_t::advanced)
+        put_advanced(bt, ln);
+    else
+        put_verbatim(bt, ln);
+}
+
+/*
+ * sexp_writer_t::begin_list()
+ * Opens a list; its elements follow until the matching end_list().
+ */
+sexp_writer_t *sexp_writer_t::begin_list(void)
+{
+    begin_element();
+    if (mode == sexp_output_stream_t::advanced)
+        output->open_list();
+    else
+        output->var_open_list();
+    depth++;
+    need_space = false;
+    return this;
+}
+
+/*
+ * sexp_writer_t::end_list()
+ * Closes the innermost open list.
+ */
+sexp_writer_t *sexp_writer_t::end_list(void)
+{
+    if (depth == 0)
+        sexp_error(sexp_exception_t::error, "There is no open list to close", EOF);
+    if (mode == sexp_output_stream_t::advanced)
+        output->close_list();
+    else
+        output->var_close_list();
+    depth--;
+    end_element();
+    return this;
+}
+
+/*
+ * sexp_writer_t::atom(bt, ln)
+ * Emits a string without presentation hint.
+ */
+sexp_writer_t *sexp_writer_t::atom(const octet_t *bt, size_t ln)
+{
+    begin_element();
+    put_simple_string(bt, ln);
+    end_element();
+    return this;
+}
+
+/*
+ * sexp_writer_t::atom_with_hint(hint, hint_ln, bt, ln)
+ * Emits a string with presentation hint.
+ */
+sexp_writer_t *sexp_writer_t::atom_with_hint(const octet_t *hint,
+                                             size_t         hint_ln,
+                                             const octet_t *bt,
+                                             size_t         ln)
+{
+    begin_element();
+    if (mode == sexp_output_stream_t::advanced)
+        output->put_char('[');
+    else
+        output->var_put_char('[');
+    put_simple_string(hint, hint_ln);
+    if (mode == sexp_output_stream_t::advanced)
+        output->put_char(']');
+    else
+        output->var_put_char(']');
+    put_simple_string(bt, ln);
+    end_element();
+    return this;
+}
+
+} // namespace sexp
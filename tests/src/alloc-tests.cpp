@@ -0,0 +1,220 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-io.h"
+
+using namespace sexp;
+
+namespace {
+
+std::atomic<size_t> allocations(0);
+
+} // namespace
+
+#ifdef SEXP_WITH_PMR
+namespace {
+
+/* Objects are allocated through the memory resource */
+class counting_resource_t : public std::pmr::memory_resource {
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/* Counts allocations from the default resource while it exists */
+class alloc_counter_t {
+    counting_resource_t        resource;
+    std::pmr::memory_resource *saved;
+
+  public:
+    alloc_counter_t(void) : saved(std::pmr::set_default_resource(&resource)) {}
+    ~alloc_counter_t() { std::pmr::set_default_resource(saved); }
+    size_t count(void) const { return allocations; }
+};
+
+} // namespace
+#else
+namespace {
+
+std::atomic<bool> counting(false);
+
+/* Counts allocations through the global operator new while it exists */
+class alloc_counter_t {
+  public:
+    alloc_counter_t(void) { counting = true; }
+    ~alloc_counter_t() { counting = false; }
+    size_t count(void) const { return allocations; }
+};
+
+} // namespace
+
+void *operator new(size_t n)
+{
+    if (counting)
+        allocations++;
+    void *p = std::malloc(n != 0 ? n : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+namespace {
+
+/* Returns the number of allocations made to scan input */
+size_t scan_allocations(const std::string &input)
+{
+    alloc_counter_t      counter;
+    sexp_memory_source_t source(input);
+    sexp_input_stream_t  is(&source);
+    is.set_byte_size(8)->get_char();
+    size_t before = counter.count();
+    auto   obj = is.scan_object();
+    return counter.count() - before;
+}
+
+const std::string long_data(40, 'x');
+
+TEST(AllocTests, EveryAtomIsAllocatedOnce)
+{
+    /* one allocation for the node, one for the presentation hint if there is one, one
+     * for each string too long to be stored inline */
+    EXPECT_EQ(scan_allocations("40:" + long_data), 2u);
+    EXPECT_EQ(scan_allocations("\"" + long_data + "\""), 2u);
+    EXPECT_EQ(scan_allocations("#" + std::string(80, 'a') + "#"), 2u);
+    EXPECT_EQ(scan_allocations("|" + std::string(56, 'Q') + "|"), 2u);
+    EXPECT_EQ(scan_allocations("token-" + long_data), 2u);
+    EXPECT_EQ(scan_allocations("[text/plain-" + long_data + "]40:" + long_data), 4u);
+    EXPECT_EQ(scan_allocations("abc"), 1u);
+    EXPECT_EQ(scan_allocations("(a b (c d))"), 6u);
+}
+
+TEST(AllocTests, MoveAwareConstruction)
+{
+    alloc_counter_t      counter;
+    sexp_simple_string_t data(reinterpret_cast<const octet_t *>(long_data.c_str()));
+    sexp_simple_string_t hint(reinterpret_cast<const octet_t *>(long_data.c_str()));
+    sexp_list_t          list;
+
+    size_t before = counter.count();
+    auto   str = list.emplace_object<sexp_string_t>(std::move(hint), std::move(data));
+    str->set_string(sexp_simple_string_t(reinterpret_cast<const octet_t *>("short")));
+    /* the string node and the hint, the buffers are taken over */
+    EXPECT_EQ(counter.count() - before, 2u);
+    EXPECT_EQ(list.size(), 1u);
+    EXPECT_EQ(str->get_presentation_hint().length(), long_data.size());
+    EXPECT_TRUE(*str == "short");
+}
+
+TEST(AllocTests, HintIsAllocatedOnlyWhenPresent)
+{
+    alloc_counter_t counter;
+    size_t          before = counter.count();
+    sexp_string_t   plain(reinterpret_cast<const octet_t *>("data"));
+    EXPECT_EQ(counter.count() - before, 0u);
+    EXPECT_FALSE(plain.has_presentation_hint());
+    EXPECT_TRUE(plain.get_presentation_hint().empty());
+
+    /* an empty hint is still a hint */
+    sexp_string_t hinted(plain);
+    hinted.set_presentation_hint(sexp_simple_string_t());
+    EXPECT_TRUE(hinted.has_presentation_hint());
+    hinted.set_presentation_hint(
+      sexp_simple_string_t(reinterpret_cast<const octet_t *>("text/plain")));
+
+    /* copies do not share the hint */
+    sexp_string_t copy(hinted);
+    hinted.set_presentation_hint(sexp_simple_string_t(reinterpret_cast<const octet_t *>("x")));
+    EXPECT_TRUE(copy.get_presentation_hint() == "text/plain");
+    EXPECT_TRUE(hinted.get_presentation_hint() == "x");
+    copy = plain;
+    EXPECT_FALSE(copy.has_presentation_hint());
+    EXPECT_FALSE(plain.has_presentation_hint());
+}
+
+TEST(AllocTests, SegmentedWideLists)
+{
+    std::string input = "(outer (a b)";
+    for (int i = 0; i < 5000; i++)
+        input += " n" + std::to_string(i);
+    input += " (inner";
+    for (int i = 0; i < 300; i++)
+        input += " x" + std::to_string(i);
+    input += "))";
+
+    sexp_memory_source_t plain_source(input);
+    sexp_input_stream_t  plain(&plain_source);
+    auto                 expected = plain.set_byte_size(8)->get_char()->scan_object();
+
+    sexp_memory_source_t source(input);
+    sexp_input_stream_t  is(&source);
+    is.set_list_segment_size(1024);
+    EXPECT_EQ(is.get_list_segment_size(), 1024u);
+    auto obj = is.set_byte_size(8)->get_char()->scan_object();
+    EXPECT_TRUE(sexp_equal(*obj, *expected));
+
+    /* wide lists are segmented, short ones are not affected */
+    auto outer = obj->sexp_list_view();
+    ASSERT_EQ(outer->size(), 5003u);
+    EXPECT_TRUE(outer->is_segmented());
+    EXPECT_EQ(outer->capacity(), 5120u);
+    EXPECT_FALSE(outer->sexp_list_at(5002)->is_segmented());
+    EXPECT_EQ(outer->sexp_list_at(1)->capacity(), sexp_list_children_t::inline_capacity);
+    EXPECT_TRUE(*outer->sexp_string_at(4002) == "n4000");
+    EXPECT_EQ(outer->find_token("inner"), outer->sexp_list_at(5002));
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj->print_canonical(&os);
+    std::ostringstream   expected_oss(std::ios_base::binary);
+    sexp_output_stream_t expected_os(&expected_oss);
+    expected->print_canonical(&expected_os);
+    EXPECT_EQ(oss.str(), expected_oss.str());
+}
+
+} // namespace
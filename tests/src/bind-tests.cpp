@@ -0,0 +1,217 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-bind.h"
+
+using namespace sexp;
+
+namespace {
+
+struct rsa_key_t {
+    sexp_simple_string_t     n;
+    sexp_simple_string_t     e;
+    uint32_t                 bits = 1024;
+    std::vector<std::string> comments;
+};
+
+struct private_key_t {
+    rsa_key_t              rsa;
+    std::string            created;
+    std::vector<rsa_key_t> subkeys;
+};
+
+} // namespace
+
+namespace sexp {
+
+template <> struct sexp_bind_t<rsa_key_t> {
+    template <typename B> static void schema(B &b)
+    {
+        b.field("n", &rsa_key_t::n);
+        b.field("e", &rsa_key_t::e);
+        b.optional("bits", &rsa_key_t::bits);
+        b.repeated("comment", &rsa_key_t::comments);
+    }
+};
+
+template <> struct sexp_bind_t<private_key_t> {
+    template <typename B> static void schema(B &b)
+    {
+        b.field("rsa", &private_key_t::rsa);
+        b.optional("created", &private_key_t::created);
+        b.repeated("subkey", &private_key_t::subkeys);
+    }
+};
+
+} // namespace sexp
+
+namespace {
+
+template <size_t N, typename T>
+void scan_into(const std::string &input, const char (&name)[N], T &value)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    sexp_bind_scan(is.set_byte_size(8)->get_char(), name, value);
+}
+
+std::string bytes(const sexp_simple_string_t &ss)
+{
+    return std::string(reinterpret_cast<const char *>(ss.data()), ss.length());
+}
+
+std::string bind_error(const std::string &input)
+{
+    private_key_t key;
+    try {
+        scan_into(input, "private-key", key);
+    } catch (sexp_exception_t &e) {
+        return e.what();
+    }
+    return std::string();
+}
+
+TEST(BindTests, ScanNestedStruct)
+{
+    private_key_t key;
+    scan_into("(private-key (protected-at [hint]\"2026\" (x y))"
+         " (rsa (e #010001#) (comment a) (n |AMEv|) (comment \"b c\") 11:not-a-field)"
+         " (subkey (n 1:x) (e 1:y) (bits 4:2048)) (subkey (n z) (e w)))",
+         "private-key",
+         key);
+
+    EXPECT_EQ(bytes(key.rsa.n), std::string("\0\xc1/", 3));
+    EXPECT_EQ(bytes(key.rsa.e), std::string("\x01\0\x01", 3));
+    EXPECT_EQ(key.rsa.bits, 1024u);
+    EXPECT_EQ(key.rsa.comments, std::vector<std::string>({"a", "b c"}));
+    EXPECT_TRUE(key.created.empty());
+    ASSERT_EQ(key.subkeys.size(), 2u);
+    EXPECT_EQ(key.subkeys[0].bits, 2048u);
+    EXPECT_TRUE(key.subkeys[0].n == "x");
+    EXPECT_TRUE(key.subkeys[1].e == "w");
+    EXPECT_EQ(key.subkeys[1].bits, 1024u);
+}
+
+TEST(BindTests, ScanValues)
+{
+    uint32_t bits = 0;
+    scan_into("(bits 4:4096)", "bits", bits);
+    EXPECT_EQ(bits, 4096u);
+    scan_into("(bits \"4294967295\")", "bits", bits);
+    EXPECT_EQ(bits, UINT32_MAX);
+
+    std::string created;
+    scan_into("(created 8:20260101)", "created", created);
+    EXPECT_EQ(created, "20260101");
+
+    /* transport encoding */
+    rsa_key_t rsa;
+    scan_into("{KDM6cnNhKDE6bjI6YWIpKDE6ZTE6Yykp}", "rsa", rsa);
+    EXPECT_TRUE(rsa.n == "ab");
+    EXPECT_TRUE(rsa.e == "c");
+}
+
+TEST(BindTests, SchemaViolations)
+{
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (e b)))"), "");
+    EXPECT_EQ(bind_error("(public-key (rsa (n a) (e b)))"),
+              "SEXP ERROR: Field 'private-key' expected, 'public-key' found at position 11");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a)))"),
+              "SEXP ERROR: Missing field 'e' at position 24");
+    EXPECT_EQ(bind_error("(private-key (created x))"),
+              "SEXP ERROR: Missing field 'rsa' at position 25");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (n b) (e c)))"),
+              "SEXP ERROR: Duplicate field 'n' at position 26");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a b) (e c)))"),
+              "SEXP ERROR: Field has more than one value at position 23");
+    EXPECT_EQ(bind_error("(private-key (rsa (n (a)) (e c)))"),
+              "SEXP ERROR: String expected at position 21");
+    EXPECT_EQ(bind_error("(private-key (rsa (n [h]a) (e c)))"),
+              "SEXP ERROR: Presentation hint is not expected in a bound field at position 21");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (e c) (bits 3:12x)))"),
+              "SEXP ERROR: Unsigned number expected at position 41");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (e c) (bits 10:4294967296)))"),
+              "SEXP ERROR: Unsigned number is too big at position 49");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (e c)"),
+              "SEXP ERROR: unexpected end of file at position 29");
+}
+
+TEST(BindTests, SkipUndeclared)
+{
+    /* skipped verbatim strings are not stored, so they are not limited in length */
+    std::string   blob(2 * 1024 * 1024, 'x');
+    private_key_t key;
+    scan_into("(private-key (blob " + std::to_string(blob.length()) + ":" + blob +
+                " [h]#00ff# |AMEv| \"q\") (rsa (n a) (e b)))",
+              "private-key",
+              key);
+    EXPECT_TRUE(key.rsa.n == "a");
+    EXPECT_TRUE(key.rsa.e == "b");
+
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (e b)) (blob 5:ab"),
+              "SEXP ERROR: EOF while reading verbatim string at position 41");
+    EXPECT_EQ(bind_error("(private-key (rsa (n a) (e b)) (blob #0g#))"),
+              "SEXP ERROR: character 'g' found in 4-bit coding region at position 39");
+}
+
+TEST(BindTests, PrintCanonical)
+{
+    private_key_t key;
+    key.rsa.n = sexp_simple_string_t(reinterpret_cast<const octet_t *>("\0\xc1/"), 3);
+    key.rsa.e = sexp_simple_string_t(reinterpret_cast<const octet_t *>("\x01\0\x01"), 3);
+    key.rsa.comments = {"a", "0123456789"};
+    key.subkeys.resize(1);
+    key.subkeys[0].bits = 0;
+
+    const std::string expected("(11:private-key(3:rsa(1:n3:\0\xc1/)(1:e3:\x01\0\x01)"
+                               "(4:bits4:1024)(7:comment1:a)(7:comment10:0123456789))"
+                               "(7:created0:)(6:subkey(1:n0:)(1:e0:)(4:bits1:0)))",
+                               143);
+    ASSERT_EQ(sexp_bind_canonical_length("private-key", key), expected.size());
+    std::vector<octet_t> buf(expected.size());
+    EXPECT_EQ(sexp_bind_print(buf.data(), "private-key", key), buf.data() + buf.size());
+    EXPECT_EQ(std::string(buf.begin(), buf.end()), expected);
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    sexp_bind_print(&os, "private-key", key);
+    EXPECT_EQ(oss.str(), expected);
+
+    /* the same image as the tree prints */
+    std::istringstream   iss(expected, std::ios_base::binary);
+    sexp_input_stream_t  is(&iss);
+    std::ostringstream   tree(std::ios_base::binary);
+    sexp_output_stream_t tos(&tree);
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&tos);
+    EXPECT_EQ(tree.str(), expected);
+
+    private_key_t copy;
+    scan_into(expected, "private-key", copy);
+    EXPECT_EQ(bytes(copy.rsa.e), bytes(key.rsa.e));
+    EXPECT_EQ(copy.rsa.comments, key.rsa.comments);
+    ASSERT_EQ(copy.subkeys.size(), 1u);
+    EXPECT_EQ(copy.subkeys[0].bits, 0u);
+}
+
+} // namespace
@@ -0,0 +1,147 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <unordered_map>
+
+#include "sexp-tests.h"
+
+using namespace sexp;
+
+namespace {
+
+std::shared_ptr<sexp_object_t> parse(const std::string &text)
+{
+    std::istringstream  iss(text);
+    sexp_input_stream_t is(&iss);
+    return is.set_byte_size(8)->get_char()->scan_object();
+}
+
+TEST(CompareTests, Equality)
+{
+    auto a = parse("(3:abc [4:hint]5:value (1:x 1:y))");
+    auto b = parse("(abc [hint]value (x y))");
+    auto c = parse("(abc [hint]value (x z))");
+    auto d = parse("(abc value (x y))");
+
+    EXPECT_TRUE(*a == *b);
+    EXPECT_FALSE(*a != *b);
+    EXPECT_FALSE(*a == *c);
+    EXPECT_FALSE(*a == *d);
+    EXPECT_EQ(sexp_hash(*a), sexp_hash(*b));
+    EXPECT_NE(sexp_hash(*a), sexp_hash(*c));
+    EXPECT_NE(sexp_hash(*a), sexp_hash(*d));
+
+    EXPECT_TRUE(*a->sexp_list_view() == *b->sexp_list_view());
+    EXPECT_EQ(std::hash<sexp_list_t>()(*a->sexp_list_view()),
+              std::hash<sexp_object_t>()(*b));
+    EXPECT_EQ(std::hash<sexp_string_t>()(*a->sexp_string_at(0)),
+              std::hash<sexp_string_t>()(sexp_string_t("abc")));
+
+    /* a string is never equal to a list holding it */
+    auto s = parse("abc");
+    auto l = parse("(abc)");
+    EXPECT_FALSE(*s == *l);
+    EXPECT_NE(sexp_hash(*s), sexp_hash(*l));
+}
+
+TEST(CompareTests, Ordering)
+{
+    const char *sorted[] = {
+      "a", "[h]a", "[i]a", "ab", "[h]ab", "b", "()", "(a)", "(a a)", "(a b)", "(b)", "((a))"};
+    for (size_t i = 0; i < sizeof(sorted) / sizeof(sorted[0]); i++) {
+        auto left = parse(sorted[i]);
+        EXPECT_EQ(sexp_compare(*left, *parse(sorted[i])), 0) << sorted[i];
+        for (size_t j = i + 1; j < sizeof(sorted) / sizeof(sorted[0]); j++) {
+            auto right = parse(sorted[j]);
+            EXPECT_TRUE(*left < *right) << sorted[i] << " < " << sorted[j];
+            EXPECT_FALSE(*right < *left) << sorted[j] << " < " << sorted[i];
+            EXPECT_GT(sexp_compare(*right, *left), 0);
+        }
+    }
+}
+
+TEST(CompareTests, HashFollowsModification)
+{
+    auto         a = parse("(key (n 1:1) (e 1:3))");
+    auto         b = parse("(key (n 1:1) (e 1:3))");
+    sexp_list_t &la = *a->sexp_list_view();
+
+    uint64_t h = sexp_hash(la);
+    EXPECT_EQ(h, sexp_hash(*b));
+    EXPECT_TRUE(la == *b->sexp_list_view());
+
+    la.push_back(std::make_shared<sexp_string_t>("extra"));
+    EXPECT_NE(sexp_hash(la), h);
+    EXPECT_FALSE(la == *b->sexp_list_view());
+
+    la.pop_back();
+    EXPECT_EQ(sexp_hash(la), h);
+    EXPECT_TRUE(la == *b->sexp_list_view());
+
+    la.replace(2, parse("(e 1:5)"));
+    EXPECT_NE(sexp_hash(la), h);
+    EXPECT_FALSE(la == *b->sexp_list_view());
+
+    sexp_list_t copy(la);
+    EXPECT_EQ(sexp_hash(copy), sexp_hash(la));
+    EXPECT_TRUE(copy == la);
+}
+
+TEST(CompareTests, HashFollowsDescendants)
+{
+    auto a = parse("(a (b) (c 1:1))");
+    auto b = parse("(a (b x) (c 1:2))");
+    EXPECT_NE(sexp_hash(*a), sexp_hash(*b));
+
+    /* descendants of a hashed list are modified through retained pointers */
+    a->sexp_list_view()->at(1)->sexp_list_view()->push_back(parse("x"));
+    EXPECT_NE(sexp_hash(*a), sexp_hash(*b));
+    a->sexp_list_view()->at(2)->sexp_list_view()->at(1)->sexp_string_view()->set_string(
+      sexp_simple_string_t(reinterpret_cast<const octet_t *>("2"), 1));
+    EXPECT_EQ(sexp_hash(*a), sexp_hash(*b));
+    EXPECT_TRUE(sexp_equal(*a, *b));
+    EXPECT_EQ(sexp_compare(*a, *b), 0);
+}
+
+TEST(CompareTests, UnorderedMapKeys)
+{
+    std::unordered_map<std::shared_ptr<sexp_object_t>,
+                       int,
+                       sexp_object_hash_t,
+                       sexp_object_equal_t>
+      seen;
+    const char *texts[] = {"(a b)", "(1:a b)", "(1:a 1:b)", "(a [h]b)", "a", "1:a"};
+    for (auto text : texts)
+        seen[parse(text)]++;
+    EXPECT_EQ(seen.size(), 3u);
+    EXPECT_EQ(seen[parse("(a b)")], 3);
+    EXPECT_EQ(seen[parse("(a [h]b)")], 1);
+    EXPECT_EQ(seen[parse("a")], 2);
+
+    std::unordered_map<sexp_string_t, int> strings;
+    strings[sexp_string_t("abc")] = 1;
+    EXPECT_EQ(strings.count(sexp_string_t("abc")), 1u);
+    EXPECT_EQ(strings.count(sexp_string_t("abd")), 0u);
+}
+
+} // namespace
@@ -0,0 +1,113 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-digest.h"
+
+using namespace sexp;
+
+namespace {
+
+std::string hex(const octet_string &bt)
+{
+    static const char *digits = "0123456789abcdef";
+    std::string        res;
+    for (auto b : bt) {
+        res.push_back(digits[b >> 4]);
+        res.push_back(digits[b & 0x0F]);
+    }
+    return res;
+}
+
+std::string digest(sexp_digest_sink_t::algorithm_t alg, const std::string &data, size_t chunk)
+{
+    sexp_digest_sink_t sink(alg);
+    const octet_t *    bt = reinterpret_cast<const octet_t *>(data.data());
+    for (size_t pos = 0; pos < data.size(); pos += chunk) {
+        size_t ln = std::min(chunk, data.size() - pos);
+        if (ln == 1)
+            sink.put(bt[pos]);
+        else
+            sink.write(bt + pos, ln);
+    }
+    return hex(sink.finish());
+}
+
+TEST(DigestTests, KnownAnswers)
+{
+    struct {
+        std::string data;
+        const char *sha1;
+        const char *sha256;
+    } cases[] = {
+      {"",
+       "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+       "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+      {"abc",
+       "a9993e364706816aba3e25717850c26c9cd0d89d",
+       "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+      {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+       "84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+       "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+      {std::string(1000000, 'a'),
+       "34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+       "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+    };
+    for (const auto &c : cases) {
+        for (size_t chunk : {1, 7, 64, 1000}) {
+            if (chunk == 1 && c.data.size() > 1000)
+                continue;
+            EXPECT_EQ(digest(sexp_digest_sink_t::sha1, c.data, chunk), c.sha1);
+            EXPECT_EQ(digest(sexp_digest_sink_t::sha256, c.data, chunk), c.sha256);
+        }
+    }
+}
+
+TEST(DigestTests, CanonicalDigest)
+{
+    std::ifstream       ifs(sexp_samples_folder + "/compat/g10/canonical.key", std::ifstream::binary);
+    sexp_input_stream_t is(&ifs);
+    auto                obj = is.set_byte_size(8)->get_char()->scan_object();
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj->print_canonical(&os);
+    std::string image = oss.str();
+
+    for (auto alg : {sexp_digest_sink_t::sha1, sexp_digest_sink_t::sha256}) {
+        octet_string res = canonical_digest(obj, alg);
+        EXPECT_EQ(res.size(), sexp_digest_sink_t(alg).digest_size());
+        EXPECT_EQ(hex(res), digest(alg, image, image.size()));
+    }
+
+    /* the sink restarts after finish() */
+    sexp_digest_sink_t   sink(sexp_digest_sink_t::sha1);
+    sexp_output_stream_t dos(&sink);
+    obj->print_canonical(&dos);
+    octet_string first = sink.finish();
+    obj->print_canonical(&dos);
+    EXPECT_EQ(sink.finish(), first);
+    EXPECT_EQ(first, canonical_digest(*obj, sexp_digest_sink_t::sha1));
+}
+
+} // namespace
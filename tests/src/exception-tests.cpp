@@ -305,6 +305,20 @@ TEST_F(ExceptionTests, MaxDepthPrintAdvanced)
     }
 }
 
+TEST_F(ExceptionTests, MaxDepthPrintAdvancedSiblings)
+{
+    /* closed lists release their depth: siblings and repeated prints do not add up */
+    std::istringstream  iss("(sexp_list_1 (sexp_list_2) (sexp_list_2) (sexp_list_2 ()))");
+    sexp_input_stream_t is(&iss);
+    sexp_list_t         lst;
+    lst.parse(is.set_byte_size(8)->get_char());
+
+    std::ostringstream   oss;
+    sexp_output_stream_t os(&oss, 3);
+    for (int i = 0; i < 4; i++)
+        EXPECT_NO_THROW(lst.print_advanced(&os));
+}
+
 TEST_F(ExceptionTests, MaxDepthPrintCanonical)
 {
     const char *depth_1 = "(sexp_list_1)";
@@ -0,0 +1,143 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-format.h"
+
+using namespace sexp;
+
+namespace {
+
+const char public_key[] = "(public-key (rsa (n %b) (e %b)))";
+
+/* Canonical image of text as read by the input stream */
+std::string canonical(const std::string &text)
+{
+    std::istringstream   iss(text, std::ios_base::binary);
+    sexp_input_stream_t  is(&iss);
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    return oss.str();
+}
+
+std::string build(const sexp_format_t &format, std::initializer_list<sexp_format_arg_t> args)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    format.print(&os, args);
+    return oss.str();
+}
+
+TEST(FormatTests, BuildsPublicKey)
+{
+    const octet_t n[] = {0x00, 0xc3, 0x5a, 0x00, 0x7f};
+    const octet_t e[] = {0x01, 0x00, 0x01};
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    sexp_build(&os, public_key, {{n, sizeof(n)}, {e, sizeof(e)}});
+    EXPECT_EQ(oss.str(), canonical("(public-key (rsa (n #00c35a007f#) (e #010001#)))"));
+    EXPECT_EQ(sexp_format_t::compiled(public_key)->arg_count(), 2u);
+}
+
+TEST(FormatTests, ConstantsInAdvancedSyntax)
+{
+    sexp_format_t format("([text/plain]\"hello world\" #0102# |AQI=| %s)");
+    EXPECT_EQ(build(format, {"tail"}),
+              canonical("([text/plain]\"hello world\" #0102# |AQI=| tail)"));
+    EXPECT_EQ(build(sexp_format_t("%s"), {std::string("a\0b", 3)}), std::string("3:a\0b", 5));
+    EXPECT_EQ(build(sexp_format_t("(x)"), {}), "(1:x)");
+}
+
+TEST(FormatTests, Numbers)
+{
+    sexp_format_t format("(%u %d %d %u %u)");
+    EXPECT_EQ(build(format, {0u, -1, 2048, 65537, std::numeric_limits<uint64_t>::max()}),
+              "(1:02:-14:20485:6553720:18446744073709551615)");
+    sexp_format_t minimum("%d");
+    EXPECT_EQ(build(minimum, {std::numeric_limits<long long>::min()}),
+              "20:-9223372036854775808");
+}
+
+TEST(FormatTests, Objects)
+{
+    std::istringstream  iss("(rsa (n #00c3#) (e #010001#))", std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    auto                key = is.set_byte_size(8)->get_char()->scan_object();
+
+    sexp_format_t format("(public-key %S (created %u))");
+    EXPECT_EQ(build(format, {*key, 1700000000u}),
+              canonical("(public-key (rsa (n #00c3#) (e #010001#)) (created 10:1700000000))"));
+}
+
+TEST(FormatTests, CompiledOncePerFormat)
+{
+    auto first = sexp_format_t::compiled(public_key);
+    auto second = sexp_format_t::compiled(public_key);
+    EXPECT_EQ(first.get(), second.get());
+}
+
+TEST(FormatTests, ReusedBufferIsCompiledAgain)
+{
+    char buffer[32];
+    std::strcpy(buffer, "(a %s)");
+    auto first = sexp_format_t::compiled(buffer);
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    sexp_build(&os, buffer, {"x"});
+    std::strcpy(buffer, "(b %u)");
+    sexp_build(&os, buffer, {7u});
+    EXPECT_EQ(oss.str(), "(1:a1:x)(1:b1:7)");
+
+    /* the format compiled before is still usable */
+    EXPECT_EQ(build(*first, {"y"}), "(1:a1:y)");
+}
+
+TEST(FormatTests, MalformedFormats)
+{
+    const char *bad[] = {"", "(a b", "a)", "(a) b", "(%x)", "(a %)", "%s %s", "3:ab"};
+    for (const char *text : bad)
+        EXPECT_THROW(sexp_format_t format(text), sexp_exception_t) << text;
+
+    try {
+        sexp_format_t format("(a %");
+        FAIL() << "sexp::sexp_exception_t expected but has not been thrown";
+    } catch (sexp::sexp_exception_t &e) {
+        EXPECT_STREQ(e.what(), "SEXP ERROR: Truncated format directive at position 4");
+    }
+}
+
+TEST(FormatTests, MismatchedArguments)
+{
+    sexp_format_t format("(n %b %u)");
+    EXPECT_THROW(build(format, {"a"}), sexp_exception_t);
+    EXPECT_THROW(build(format, {"a", 1u, 2u}), sexp_exception_t);
+    EXPECT_THROW(build(format, {1u, 1u}), sexp_exception_t);
+    EXPECT_THROW(build(format, {"a", -1}), sexp_exception_t);
+    EXPECT_THROW(build(format, {"a", "b"}), sexp_exception_t);
+    EXPECT_THROW(build(sexp_format_t("%S"), {"a"}), sexp_exception_t);
+}
+
+} // namespace
@@ -0,0 +1,187 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <thread>
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-hashcons.h"
+
+using namespace sexp;
+
+namespace {
+
+const char *record_sample = "(record (id 1:1) (curve (name \"NIST P-256\") (bits 3:256)) "
+                            "(flags (sign verify)) (key #00c12f77#))";
+
+std::shared_ptr<sexp_object_t> parse(const std::string &input, sexp_hashcons_table_t *table)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return is.set_hashcons_table(table)->set_byte_size(8)->get_char()->scan_object();
+}
+
+std::string canonical(const std::shared_ptr<sexp_object_t> &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj->print_canonical(&os);
+    return oss.str();
+}
+
+TEST(HashconsTests, SharedSubtrees)
+{
+    sexp_hashcons_table_t table;
+    auto                  first = parse(record_sample, &table);
+    auto                  second = parse(record_sample, &table);
+    auto                  other = parse("(record (id 1:2) (curve (name \"NIST P-256\") "
+                                         "(bits 3:256)) (flags (sign verify)) (key #0d0e#))",
+                                         &table);
+    EXPECT_EQ(canonical(first), canonical(parse(record_sample, nullptr)));
+
+    /* identical trees are one node */
+    EXPECT_EQ(first, second);
+
+    /* shared subtrees of different trees too */
+    const auto *l1 = first->sexp_list_view();
+    const auto *l2 = other->sexp_list_view();
+    EXPECT_NE(l1, l2);
+    EXPECT_EQ(l1->at(0), l2->at(0));
+    EXPECT_NE(l1->at(1), l2->at(1));
+    EXPECT_EQ(l1->at(2), l2->at(2));
+    EXPECT_EQ(l1->at(3), l2->at(3));
+    EXPECT_NE(l1->at(4), l2->at(4));
+    EXPECT_FALSE(*first == *other);
+
+    auto id1 = l1->sexp_list_at(1)->at(0);
+    auto id2 = l2->sexp_list_at(1)->at(0);
+    EXPECT_EQ(id1, id2);
+}
+
+TEST(HashconsTests, HintsAndKindsAreDistinct)
+{
+    sexp_hashcons_table_t table;
+    auto                  obj = parse("(a [h]a (a) ((a)) [i]a a)", &table);
+    const auto *          l = obj->sexp_list_view();
+    EXPECT_NE(l->at(0), l->at(1));
+    EXPECT_NE(l->at(1), l->at(4));
+    EXPECT_NE(l->at(0), l->at(2));
+    EXPECT_NE(l->at(2), l->at(3));
+    EXPECT_EQ(l->at(0), l->at(5));
+    EXPECT_EQ(l->at(0), l->sexp_list_at(2)->at(0));
+    EXPECT_EQ(l->at(2), l->sexp_list_at(3)->at(0));
+    /* a, [h]a, [i]a, (a), ((a)) and the list itself */
+    EXPECT_EQ(table.size(), 6u);
+}
+
+TEST(HashconsTests, PurgeAndClear)
+{
+    sexp_hashcons_table_t table;
+    auto                  kept = parse("(kept (x y))", &table);
+    parse("(dropped (x z) (deep (deeper)))", &table);
+    /* kept (x y) x y (kept ...) + dropped z (x z) deep deeper (deeper) (deep ...) (...) */
+    EXPECT_EQ(table.size(), 13u);
+    EXPECT_EQ(table.purge(), 8u);
+    EXPECT_EQ(table.size(), 5u);
+    EXPECT_EQ(parse("(kept (x y))", &table), kept);
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_EQ(canonical(kept), "(4:kept(1:x1:y))");
+    EXPECT_NE(parse("(kept (x y))", &table), kept);
+}
+
+TEST(HashconsTests, SharedNodesAreNotModified)
+{
+    sexp_hashcons_table_t table;
+    auto                  first = parse("(flags (sign verify))", &table);
+    auto                  second = parse("(flags (sign verify))", &table);
+    auto *                flags = first->sexp_list_view()->at(1)->sexp_list_view();
+    EXPECT_TRUE(first->is_shared());
+    EXPECT_TRUE(flags->is_shared());
+    EXPECT_THROW(flags->push_back(std::make_shared<sexp_string_t>("encrypt")),
+                 sexp_exception_t);
+    EXPECT_THROW(flags->erase(flags->begin()), sexp_exception_t);
+    EXPECT_THROW(flags->at(0)->sexp_string_view()->set_string(
+                   sexp_simple_string_t(reinterpret_cast<const octet_t *>("x"), 1)),
+                 sexp_exception_t);
+    EXPECT_EQ(canonical(second), "(5:flags(4:sign6:verify))");
+
+    /* a private copy of the shared list may be modified */
+    sexp_list_t copy(*flags);
+    EXPECT_FALSE(copy.is_shared());
+    copy.push_back(std::make_shared<sexp_string_t>("encrypt"));
+    EXPECT_EQ(copy.size(), 3u);
+    EXPECT_NE(sexp_hash(copy), sexp_hash(*flags));
+
+    /* nodes of hand-built lists become shared with the list */
+    auto list = std::make_shared<sexp_list_t>();
+    auto atom = std::make_shared<sexp_string_t>("x");
+    list->push_back(atom);
+    EXPECT_EQ(table.share(list), list);
+    EXPECT_TRUE(atom->is_shared());
+}
+
+TEST(HashconsTests, TokenAtoms)
+{
+    sexp_hashcons_table_t table(sexp_hashcons_table_t::token_atoms);
+    auto                  first = parse(record_sample, &table);
+    auto                  second = parse(record_sample, &table);
+    EXPECT_EQ(canonical(first), canonical(parse(record_sample, nullptr)));
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(first->is_shared());
+
+    const auto *l1 = first->sexp_list_view();
+    const auto *l2 = second->sexp_list_view();
+    /* lists of tokens are shared */
+    EXPECT_EQ(l1->at(0), l2->at(0));
+    EXPECT_EQ(l1->at(3), l2->at(3));
+    /* non-token atoms and the lists holding them are not */
+    EXPECT_NE(l1->at(1), l2->at(1));
+    EXPECT_NE(l1->at(2), l2->at(2));
+    EXPECT_EQ(l1->sexp_list_at(2)->at(0), l2->sexp_list_at(2)->at(0));
+    EXPECT_NE(l1->at(4), l2->at(4));
+    EXPECT_FALSE(l1->sexp_list_at(4)->at(1)->is_shared());
+
+    auto hinted = parse("[h]a", &table);
+    EXPECT_NE(parse("[h]a", &table), hinted);
+    /* record id curve name bits flags sign verify (sign verify) (flags ...) key */
+    EXPECT_EQ(table.size(), 11u);
+}
+
+TEST(HashconsTests, ConcurrentParsing)
+{
+    sexp_hashcons_table_t                       table;
+    std::vector<std::shared_ptr<sexp_object_t>> results(4);
+    std::vector<std::thread>                    threads;
+    for (size_t i = 0; i < results.size(); i++)
+        threads.emplace_back([&table, &results, i]() {
+            for (int j = 0; j < 50; j++)
+                results[i] = parse(record_sample, &table);
+        });
+    for (auto &t : threads)
+        t.join();
+    for (auto &r : results)
+        EXPECT_EQ(r, results[0]);
+}
+
+} // namespace
@@ -0,0 +1,138 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <thread>
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-intern.h"
+
+using namespace sexp;
+
+namespace {
+
+const char *key_sample = "(private-key (rsa (n #00c12f77#) (e #010001#) (d #5a3f#)) "
+                         "[text/plain]comment ([text/plain]comment \"with space\"))";
+
+std::shared_ptr<sexp_object_t> parse(const std::string &input, sexp_intern_table_t *table)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return is.set_intern_table(table)->set_byte_size(8)->get_char()->scan_object();
+}
+
+std::string canonical(const std::shared_ptr<sexp_object_t> &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj->print_canonical(&os);
+    return oss.str();
+}
+
+TEST(InternTests, SharedTokens)
+{
+    sexp_intern_table_t table;
+    auto                first = parse(key_sample, &table);
+    auto                second = parse(key_sample, &table);
+    EXPECT_EQ(canonical(first), canonical(parse(key_sample, nullptr)));
+    EXPECT_EQ(canonical(first), canonical(second));
+
+    const auto *l1 = first->sexp_list_view();
+    const auto *l2 = second->sexp_list_view();
+    /* tokens are shared between trees and compare by pointer */
+    EXPECT_EQ(l1->at(0), l2->at(0));
+    EXPECT_EQ(l1->at(0), table.intern("private-key"));
+    EXPECT_EQ(l1->sexp_list_at(1)->at(0), table.intern("rsa"));
+    /* hinted tokens are shared, but differ from the same token without hint */
+    EXPECT_EQ(l1->at(2), l2->at(2));
+    EXPECT_EQ(l1->at(2), l1->sexp_list_at(3)->at(0));
+    EXPECT_NE(l1->at(2), table.intern("comment"));
+    /* binary values and non-token strings are not retained */
+    const auto *n1 = l1->sexp_list_at(1)->sexp_list_at(1);
+    const auto *n2 = l2->sexp_list_at(1)->sexp_list_at(1);
+    EXPECT_EQ(n1->at(0), n2->at(0));
+    EXPECT_NE(n1->at(1), n2->at(1));
+    EXPECT_NE(l1->sexp_list_at(3)->at(1), l2->sexp_list_at(3)->at(1));
+    /* private-key rsa n e d [text/plain]comment, and comment added by intern() */
+    EXPECT_EQ(table.size(), 7);
+}
+
+TEST(InternTests, CopyOnWrite)
+{
+    sexp_intern_table_t  table;
+    auto                 first = parse("(rsa (e \"a b\"))", &table);
+    auto                 second = parse("(rsa (e \"a b\"))", &table);
+    auto *               l1 = first->sexp_list_view();
+    sexp_simple_string_t dsa(reinterpret_cast<const octet_t *>("dsa"), 3);
+
+    EXPECT_TRUE(l1->at(0)->is_shared());
+    EXPECT_THROW(l1->at(0)->sexp_string_view()->set_string(dsa), sexp_exception_t);
+    EXPECT_THROW(l1->at(0)->sexp_string_view()->set_presentation_hint(dsa), sexp_exception_t);
+
+    /* the element is replaced by a private copy, other trees keep the shared node */
+    l1->unshare(0)->sexp_string_view()->set_string(dsa);
+    EXPECT_FALSE(l1->at(0)->is_shared());
+    EXPECT_EQ(canonical(first), "(3:dsa(1:e3:a b))");
+    EXPECT_EQ(canonical(second), "(3:rsa(1:e3:a b))");
+    EXPECT_EQ(second->sexp_list_view()->at(0), table.intern("rsa"));
+
+    /* unshared elements are returned as they are */
+    auto e = l1->sexp_list_view()->at(1)->sexp_list_view();
+    auto v = e->at(1);
+    EXPECT_EQ(e->unshare(1), v);
+}
+
+TEST(InternTests, MaxLength)
+{
+    sexp_intern_table_t table(4);
+    auto                obj = parse("(abcd abcde abcd abcde)", &table);
+    const auto *        list = obj->sexp_list_view();
+    EXPECT_EQ(list->at(0), list->at(2));
+    EXPECT_NE(list->at(1), list->at(3));
+    EXPECT_EQ(table.size(), 1);
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(*list->sexp_string_at(0), "abcd");
+    EXPECT_NE(list->at(0), table.intern("abcd"));
+}
+
+TEST(InternTests, ConcurrentUse)
+{
+    sexp_intern_table_t                         table;
+    std::vector<std::shared_ptr<sexp_object_t>> results(4);
+    std::vector<std::thread>                    threads;
+    for (size_t i = 0; i < results.size(); i++)
+        threads.emplace_back([&, i]() {
+            for (int k = 0; k < 50; k++)
+                results[i] = parse(key_sample, &table);
+        });
+    for (auto &thread : threads)
+        thread.join();
+    for (const auto &res : results) {
+        EXPECT_EQ(canonical(res), canonical(results[0]));
+        EXPECT_EQ(res->sexp_list_view()->at(0), table.intern("private-key"));
+    }
+    EXPECT_EQ(table.size(), 6);
+}
+
+} // namespace
@@ -0,0 +1,154 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <thread>
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-intrusive.h"
+
+using namespace sexp;
+
+namespace {
+
+const char *key_sample = "(private-key (rsa (n #00c12f77#) (e #010001#) (d #5a3f#)) "
+                         "[text/plain]comment {KDM6YWJjKQ==} ())";
+
+template <typename T> std::string canonical(const T &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj->print_canonical(&os);
+    return oss.str();
+}
+
+template <typename Node> typename Node::ptr_t scan(const std::string &input)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return Node::scan(is.set_byte_size(8)->get_char());
+}
+
+std::shared_ptr<sexp_object_t> parse(const std::string &input)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return is.set_byte_size(8)->get_char()->scan_object();
+}
+
+TEST(IntrusiveTests, Pointer)
+{
+    typedef sexp_local_ref_object_t::ptr_t ptr_t;
+    ptr_t                                  a = scan<sexp_local_ref_object_t>("(a b)");
+    EXPECT_EQ(a.use_count(), 1u);
+    {
+        ptr_t b = a;
+        EXPECT_EQ(a.use_count(), 2u);
+        EXPECT_TRUE(b == a);
+        ptr_t c = std::move(b);
+        EXPECT_EQ(b, nullptr);
+        EXPECT_EQ(a.use_count(), 2u);
+    }
+    EXPECT_EQ(a.use_count(), 1u);
+
+    ptr_t child = (*a->list_view())[1];
+    EXPECT_EQ(child.use_count(), 2u);
+    a.reset();
+    EXPECT_EQ(a, nullptr);
+    EXPECT_EQ(child.use_count(), 1u);
+    EXPECT_EQ(canonical(child), "1:b");
+}
+
+TEST(IntrusiveTests, SameImages)
+{
+    const std::string image = canonical(parse(key_sample));
+    EXPECT_EQ(canonical(scan<sexp_local_ref_object_t>(key_sample)), image);
+    EXPECT_EQ(canonical(scan<sexp_shared_ref_object_t>(key_sample)), image);
+
+    auto node = scan<sexp_shared_ref_object_t>(key_sample);
+    EXPECT_EQ(canonical(node->to_object()), image);
+    EXPECT_EQ(canonical(sexp_local_ref_object_t::from_object(*parse(key_sample))), image);
+
+    const auto *list = node->list_view();
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(list->size(), 5u);
+    EXPECT_EQ((*list)[2]->list_view(), nullptr);
+    EXPECT_TRUE((*list)[2]->string_view()->has_presentation_hint());
+    EXPECT_TRUE((*list)[4]->is_sexp_list());
+
+    EXPECT_THROW(scan<sexp_local_ref_object_t>("(a (b)"), sexp_exception_t);
+}
+
+/* an object that is neither a string nor a list */
+class opaque_object_t : public sexp_object_t {
+  public:
+    sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const override
+    {
+        return os;
+    }
+    size_t advanced_length(sexp_output_stream_t *) const override { return 0; }
+};
+
+class derived_string_t : public sexp_string_t {
+  public:
+    derived_string_t(void) : sexp_string_t("x") {}
+};
+
+TEST(IntrusiveTests, UnsupportedObjects)
+{
+    EXPECT_THROW(sexp_local_ref_object_t::from_object(opaque_object_t()), sexp_exception_t);
+    EXPECT_THROW(sexp_local_ref_object_t::from_object(derived_string_t()), sexp_exception_t);
+
+    sexp_list_t list;
+    list.push_back(parse("a"));
+    list.push_back(std::make_shared<sexp_list_t>());
+    EXPECT_NO_THROW(sexp_local_ref_object_t::from_object(list));
+    list.push_back(std::make_shared<derived_string_t>());
+    EXPECT_THROW(sexp_local_ref_object_t::from_object(list), sexp_exception_t);
+    list.replace(2, nullptr);
+    EXPECT_THROW(sexp_local_ref_object_t::from_object(list), sexp_exception_t);
+}
+
+TEST(IntrusiveTests, SharedBetweenThreads)
+{
+    auto                     node = scan<sexp_shared_ref_object_t>(key_sample);
+    const std::string        image = canonical(node);
+    std::vector<std::thread> threads;
+    std::vector<bool>        ok(4, false);
+    for (size_t i = 0; i < ok.size(); i++)
+        threads.emplace_back([&node, &image, &ok, i]() {
+            bool good = true;
+            for (int j = 0; j < 200; j++) {
+                sexp_shared_ref_object_t::ptr_t copy = node;
+                sexp_shared_ref_object_t::ptr_t rsa = (*copy->list_view())[1];
+                good = good && canonical(copy) == image && rsa->is_sexp_list();
+            }
+            ok[i] = good;
+        });
+    for (auto &t : threads)
+        t.join();
+    for (size_t i = 0; i < ok.size(); i++)
+        EXPECT_TRUE(ok[i]);
+    EXPECT_EQ(node.use_count(), 1u);
+}
+
+} // namespace
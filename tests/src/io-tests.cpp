@@ -0,0 +1,186 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-io.h"
+
+using namespace sexp;
+
+namespace {
+
+const char *sample = "(3:abc(1:x#0102#)\"quoted string\"[4:text]5:hello)";
+
+/* Streams hold pointers to adapters inside themselves, copies would dangle */
+static_assert(!std::is_copy_constructible<sexp_input_stream_t>::value &&
+                !std::is_move_constructible<sexp_input_stream_t>::value &&
+                !std::is_copy_assignable<sexp_input_stream_t>::value,
+              "input stream is not copyable");
+static_assert(!std::is_copy_constructible<sexp_output_stream_t>::value &&
+                !std::is_move_constructible<sexp_output_stream_t>::value &&
+                !std::is_copy_assignable<sexp_output_stream_t>::value,
+              "output stream is not copyable");
+
+std::string canonical(const std::string &input)
+{
+    std::istringstream   iss(input, std::ios_base::binary);
+    sexp_input_stream_t  is(&iss);
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    return oss.str();
+}
+
+TEST(IoTests, MemorySourceAndSink)
+{
+    std::string          input(sample);
+    sexp_memory_source_t source(input);
+    sexp_input_stream_t  is(&source);
+    sexp_memory_sink_t   sink;
+    sexp_output_stream_t os(&sink);
+
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    EXPECT_EQ(sink.str(), canonical(input));
+    EXPECT_EQ(source.remaining(), 0);
+}
+
+TEST(IoTests, SourcePrimitives)
+{
+    sexp_memory_source_t source("abcdef", 6);
+    octet_t              buf[4];
+
+    EXPECT_EQ(source.peek(), 'a');
+    EXPECT_EQ(source.get(), 'a');
+    EXPECT_EQ(source.read(buf, sizeof(buf)), 4);
+    EXPECT_EQ(memcmp(buf, "bcde", 4), 0);
+    EXPECT_EQ(source.read(buf, sizeof(buf)), 1);
+    EXPECT_EQ(source.peek(), EOF);
+    EXPECT_EQ(source.get(), EOF);
+}
+
+TEST(IoTests, CallbackSourceSmallChunks)
+{
+    std::string input(sample);
+    size_t      offset = 0;
+    size_t      calls = 0;
+    /* reader returns at most 3 bytes at a time, buffer is even smaller */
+    sexp_callback_source_t source(
+      [&](octet_t *bt, size_t ln) {
+          calls++;
+          size_t chunk = std::min(std::min(ln, (size_t) 3), input.size() - offset);
+          memcpy(bt, input.data() + offset, chunk);
+          offset += chunk;
+          return chunk;
+      },
+      2);
+    sexp_input_stream_t  is(&source);
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    EXPECT_EQ(oss.str(), canonical(input));
+    EXPECT_GT(calls, input.size() / 2);
+}
+
+TEST(IoTests, CallbackSinkBuffering)
+{
+    std::string out;
+    size_t      calls = 0;
+    {
+        sexp_callback_sink_t sink(
+          [&](const octet_t *bt, size_t ln) {
+              calls++;
+              out.append(reinterpret_cast<const char *>(bt), ln);
+          },
+          8);
+        sexp_output_stream_t os(&sink);
+        std::istringstream  iss(sample, std::ios_base::binary);
+        sexp_input_stream_t is(&iss);
+        is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+        sink.flush();
+        EXPECT_EQ(out, canonical(sample));
+        EXPECT_GT(calls, 1);
+
+        /* large blocks bypass the buffer, the tail is delivered on destruction */
+        std::string big(100, 'z');
+        sink.write(reinterpret_cast<const octet_t *>(big.data()), big.size());
+        sink.put('!');
+    }
+    EXPECT_EQ(out, canonical(sample) + std::string(100, 'z') + "!");
+}
+
+TEST(IoTests, AdvancedOutputToSink)
+{
+    std::istringstream   iss(sample, std::ios_base::binary);
+    sexp_input_stream_t  is(&iss);
+    auto                 obj = is.set_byte_size(8)->get_char()->scan_object();
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os_stream(&oss);
+    sexp_memory_sink_t   sink;
+    sexp_output_stream_t os_sink(&sink);
+
+    obj->print_advanced(&os_stream);
+    obj->print_advanced(&os_sink);
+    EXPECT_EQ(sink.str(), oss.str());
+    os_stream.print_base64(obj);
+    os_sink.print_base64(obj);
+    EXPECT_EQ(sink.str(), oss.str());
+}
+
+TEST(IoTests, FileDescriptors)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    {
+        sexp_fd_sink_t       sink(fds[1], 4);
+        sexp_output_stream_t os(&sink);
+        std::istringstream   iss(sample, std::ios_base::binary);
+        sexp_input_stream_t  is(&iss);
+        is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    }
+    close(fds[1]);
+
+    sexp_fd_source_t     source(fds[0], 5);
+    sexp_input_stream_t  is(&source);
+    sexp_memory_sink_t   sink;
+    sexp_output_stream_t os(&sink);
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    close(fds[0]);
+    EXPECT_EQ(sink.str(), canonical(sample));
+}
+
+TEST(IoTests, IstreamSourceDoesNotReadAhead)
+{
+    /* the adapter takes bytes one by one: the parser stops right after the first object
+     * and its lookahead character, the rest stays in the stream */
+    std::istringstream  iss(std::string("(1:a) (1:b)"), std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    is.set_byte_size(8)->get_char()->scan_object();
+    std::string rest;
+    std::getline(iss, rest);
+    EXPECT_EQ(rest, "(1:b)");
+}
+
+} // namespace
@@ -0,0 +1,145 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-iovec.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace sexp;
+
+namespace {
+
+std::shared_ptr<sexp_object_t> parse(const std::string &str)
+{
+    std::istringstream  iss(str, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return is.set_byte_size(8)->get_char()->scan_object();
+}
+
+std::string canonical(const std::shared_ptr<sexp_object_t> &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    os.print_canonical(obj);
+    return oss.str();
+}
+
+std::string to_string(const octet_string &str)
+{
+    return std::string(reinterpret_cast<const char *>(str.data()), str.length());
+}
+
+TEST(IovecTests, Samples)
+{
+    const char *samples[] = {"()", "abc", "(a (b c) [hint]d)", "(\"\" ())"};
+    for (const char *sample : samples) {
+        auto         obj = parse(sample);
+        sexp_iovec_t iov;
+        iov.add(obj);
+        EXPECT_EQ(to_string(iov.str()), canonical(obj));
+        EXPECT_EQ(iov.size(), canonical(obj).length());
+    }
+}
+
+TEST(IovecTests, Baseline)
+{
+    std::ifstream ifs(sexp_samples_folder + "/baseline/sexp-sample-a", std::ifstream::binary);
+    EXPECT_FALSE(ifs.fail());
+    sexp_input_stream_t is(&ifs);
+    const auto          obj = is.set_byte_size(8)->get_char()->scan_object();
+
+    sexp_iovec_t iov(0);
+    iov.add(obj);
+    EXPECT_EQ(to_string(iov.str()), canonical(obj));
+}
+
+TEST(IovecTests, LargeAtomsAreReferenced)
+{
+    std::string  mpi(1000, 'x');
+    auto obj = parse("(rsa (n " + std::to_string(mpi.size()) + ":" + mpi + ") (e #010001#))");
+    const auto * n = obj->sexp_list_view()->sexp_list_at(1)->sexp_simple_string_at(1);
+    sexp_iovec_t iov;
+    iov.add(obj);
+
+    auto segments = iov.segments();
+    ASSERT_EQ(segments.size(), 3);
+    EXPECT_EQ(to_string(octet_string(segments[0].data, segments[0].length)), "(3:rsa(1:n1000:");
+    EXPECT_EQ(segments[1].data, n->data());
+    EXPECT_EQ(segments[1].length, mpi.size());
+    EXPECT_EQ(to_string(octet_string(segments[2].data, segments[2].length)),
+              std::string(")(1:e3:\x01\x00\x01))", 12));
+    EXPECT_EQ(to_string(iov.str()), canonical(obj));
+
+    iov.clear()->add(obj)->add(obj);
+    EXPECT_EQ(to_string(iov.str()), canonical(obj) + canonical(obj));
+}
+
+TEST(IovecTests, MaxDepth)
+{
+    auto         obj = parse("(((a)))");
+    sexp_iovec_t iov(sexp_iovec_t::DEFAULT_INLINE_LIMIT, 2);
+    EXPECT_THROW(iov.add(obj), sexp_exception_t);
+}
+
+TEST(IovecTests, FailedAddLeavesSegments)
+{
+    auto         ok = parse("((a) b)");
+    auto         deep = parse("(c ((d)))");
+    sexp_iovec_t iov(sexp_iovec_t::DEFAULT_INLINE_LIMIT, 2);
+    iov.add(ok);
+    size_t count = iov.count();
+    EXPECT_THROW(iov.add(deep), sexp_exception_t);
+    EXPECT_EQ(iov.count(), count);
+    EXPECT_EQ(to_string(iov.str()), canonical(ok));
+    /* the depth of the failed call is not carried over */
+    iov.add(ok);
+    EXPECT_EQ(to_string(iov.str()), canonical(ok) + canonical(ok));
+}
+
+#ifndef _WIN32
+TEST(IovecTests, Writev)
+{
+    std::string  mpi(512, 'y');
+    auto         obj = parse("(a (b " + std::to_string(mpi.size()) + ":" + mpi + ") c)");
+    sexp_iovec_t iov(16);
+    iov.add(obj)->add(obj);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_EQ(iov.writev(fds[1]), iov.size());
+    close(fds[1]);
+
+    std::string res;
+    char        buf[256];
+    ssize_t     n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        res.append(buf, n);
+    close(fds[0]);
+    EXPECT_EQ(res, canonical(obj) + canonical(obj));
+}
+#endif
+
+} // namespace
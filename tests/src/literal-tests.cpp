@@ -0,0 +1,129 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-literal.h"
+
+#ifdef SEXP_WITH_LITERALS
+
+using namespace sexp;
+
+namespace {
+
+/* Encoded by the compiler */
+constexpr auto skeleton = sexp_literal("(public-key (rsa (n) (e #010001#)))");
+static_assert(skeleton.size() == 37, "canonical image of the skeleton");
+static_assert(skeleton.data()[0] == '(' && skeleton.data()[1] == '1' &&
+                skeleton.data()[2] == '0' && skeleton.data()[3] == ':',
+              "length prefix of public-key");
+
+std::string image(const octet_t *bt, size_t ln)
+{
+    return std::string(reinterpret_cast<const char *>(bt), ln);
+}
+
+/* Canonical image of text as read by the input stream */
+std::string canonical(const std::string &text)
+{
+    std::istringstream   iss(text, std::ios_base::binary);
+    sexp_input_stream_t  is(&iss);
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    is.set_byte_size(8)->get_char()->scan_object()->print_canonical(&os);
+    return oss.str();
+}
+
+#define EXPECT_LITERAL(text)                                                                  \
+    do {                                                                                      \
+        constexpr auto lit = sexp_literal(text);                                              \
+        EXPECT_EQ(image(lit.data(), lit.size()), canonical(text));                            \
+    } while (0)
+
+TEST(LiteralTests, SameImageAsInputStream)
+{
+    EXPECT_EQ(image(skeleton.data(), skeleton.size()),
+              std::string("(10:public-key(3:rsa(1:n)(1:e3:\x01\x00\x01)))", 37));
+    EXPECT_LITERAL("token");
+    EXPECT_LITERAL("  ( a-b.c/d_e=f+g:h ) ");
+    EXPECT_LITERAL("(3:abc 3:d f 0:)");
+    EXPECT_LITERAL("(\"a b\" 4\"x\\ty\\\"\" \"\\x41\\101\\'\\\\\" \"line\\\ncontinued\")");
+    EXPECT_LITERAL("(#00 c1 2F# 2#0102# ## |AMEv| |AQ==| 3|AQAB|)");
+    EXPECT_LITERAL("([text/plain] \"hello\" [ 4:hint ] data (nested (lists ()) here))");
+    EXPECT_LITERAL("(12:0123456789ab \"\" x10:0123456789)");
+    EXPECT_LITERAL("(tag (* set a b))");
+}
+
+TEST(LiteralTests, SameTokenCharacters)
+{
+    /* whatever the input stream accepts in a token, the literal accepts too; ')' ends
+     * the object early, which the literal rejects */
+    for (int c = 1; c < 256; c++) {
+        if (c == ')')
+            continue;
+        std::string text = std::string("(x") + (char) c + "y)";
+        std::string expected;
+        try {
+            expected = canonical(text);
+        } catch (const sexp_exception_t &) {
+            continue;
+        }
+        sexp_literal_t<64> lit(text.c_str(), text.size());
+        EXPECT_EQ(image(lit.data(), lit.size()), expected) << "character " << c;
+    }
+}
+
+TEST(LiteralTests, UseAsObject)
+{
+    auto obj = skeleton.to_object();
+    ASSERT_TRUE(obj->is_sexp_list());
+    EXPECT_TRUE(*obj->sexp_list_view()->sexp_string_at(0) == "public-key");
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    skeleton.print_canonical(&os);
+    EXPECT_EQ(oss.str(), image(skeleton.data(), skeleton.size()));
+}
+
+TEST(LiteralTests, MalformedAtRunTime)
+{
+    /* not constant expressions, so errors are reported when the text is parsed */
+    const char *bad[] = {"(a b",
+                         "a)",
+                         "(a) b",
+                         "",
+                         "3:ab",
+                         "2\"abc\"",
+                         "#abc#",
+                         "|AR|",
+                         "\"\\q\"",
+                         "[hint",
+                         "(a {b})"};
+    for (const char *text : bad) {
+        std::string copy(text);
+        EXPECT_THROW(sexp_literal_t<64>(copy.c_str(), copy.size()), sexp_exception_t) << text;
+    }
+}
+
+} // namespace
+
+#endif // SEXP_WITH_LITERALS
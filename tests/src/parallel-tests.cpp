@@ -0,0 +1,108 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+
+using namespace sexp;
+
+namespace {
+
+std::shared_ptr<sexp_list_t> build_inventory(size_t n)
+{
+    auto inventory = std::make_shared<sexp_list_t>();
+    inventory->push_back(std::make_shared<sexp_string_t>(std::string("inventory")));
+    for (size_t i = 0; i < n; i++) {
+        auto item = std::make_shared<sexp_list_t>();
+        item->push_back(std::make_shared<sexp_string_t>(std::string("item")));
+        item->push_back(std::make_shared<sexp_string_t>(std::to_string(i)));
+        if (i % 3 == 0) {
+            auto nested = std::make_shared<sexp_list_t>();
+            nested->push_back(std::make_shared<sexp_string_t>(std::string("tag")));
+            item->push_back(nested);
+        }
+        inventory->push_back(item);
+    }
+    return inventory;
+}
+
+TEST(ParallelTests, SameAsSerial)
+{
+    for (size_t n : {0, 10, 1000, 20000}) {
+        std::shared_ptr<sexp_object_t> obj = build_inventory(n);
+
+        std::ostringstream   oss1(std::ios_base::binary);
+        sexp_output_stream_t os1(&oss1);
+        os1.print_canonical(obj);
+
+        for (unsigned threads : {0, 1, 3, 8}) {
+            std::ostringstream   oss2(std::ios_base::binary);
+            sexp_output_stream_t os2(&oss2);
+            os2.print_canonical_parallel(obj, threads);
+            EXPECT_EQ(oss2.str(), oss1.str());
+        }
+    }
+}
+
+TEST(ParallelTests, Base64)
+{
+    std::shared_ptr<sexp_object_t> obj = build_inventory(5000);
+
+    std::ostringstream   oss1(std::ios_base::binary);
+    sexp_output_stream_t os1(&oss1);
+    os1.set_max_column(0)->print_base64(obj);
+
+    std::ostringstream   oss2(std::ios_base::binary);
+    sexp_output_stream_t os2(&oss2);
+    os2.set_max_column(0)
+      ->change_output_byte_size(8, sexp_output_stream_t::base64)
+      ->var_put_char('{')
+      ->change_output_byte_size(6, sexp_output_stream_t::base64)
+      ->print_canonical_parallel(obj, 4)
+      ->flush()
+      ->change_output_byte_size(8, sexp_output_stream_t::base64)
+      ->var_put_char('}');
+    EXPECT_EQ(oss2.str(), oss1.str());
+}
+
+TEST(ParallelTests, MaxDepth)
+{
+    auto obj = build_inventory(1000);
+    auto deep = std::make_shared<sexp_list_t>();
+    deep->push_back(std::make_shared<sexp_list_t>());
+    deep->at(0)->sexp_list_view()->push_back(std::make_shared<sexp_list_t>());
+    obj->push_back(deep);
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss, 3);
+    EXPECT_THROW(os.print_canonical_parallel(obj, 4), sexp_exception_t);
+    /* the failed call does not leave the depth of the top-level list behind */
+    oss.str("");
+    EXPECT_NO_THROW(os.print_canonical(deep));
+    EXPECT_EQ(oss.str(), "((()))");
+
+    std::ostringstream   oss2(std::ios_base::binary);
+    sexp_output_stream_t os2(&oss2, 4);
+    EXPECT_NO_THROW(os2.print_canonical_parallel(obj, 4));
+}
+
+} // namespace
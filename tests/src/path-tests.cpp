@@ -0,0 +1,161 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-path.h"
+
+using namespace sexp;
+
+namespace {
+
+class PathTests : public testing::Test {
+  protected:
+    static const char *sample;
+
+    std::shared_ptr<sexp_object_t> tree;
+    std::string                    image;
+
+    void SetUp() override
+    {
+        std::istringstream  iss(sample, std::ios_base::binary);
+        sexp_input_stream_t is(&iss);
+        tree = is.set_byte_size(8)->get_char()->scan_object();
+
+        std::ostringstream   oss(std::ios_base::binary);
+        sexp_output_stream_t os(&oss);
+        tree->print_canonical(&os);
+        image = oss.str();
+    }
+
+    /* Canonical image of the first match in the tree */
+    std::string tree_match(const sexp_path_t &path) const
+    {
+        const sexp_list_t *list = path.find(*tree);
+        if (list == nullptr)
+            return "";
+        std::ostringstream   oss(std::ios_base::binary);
+        sexp_output_stream_t os(&oss);
+        list->print_canonical(&os);
+        return oss.str();
+    }
+
+    std::string image_match(const sexp_path_t &path) const
+    {
+        sexp_path_t::span_t span;
+        if (!path.find(reinterpret_cast<const octet_t *>(image.data()), image.size(), span))
+            return "";
+        return std::string(reinterpret_cast<const char *>(span.data), span.length);
+    }
+
+    std::string image_value(const sexp_path_t &path) const
+    {
+        sexp_path_t::span_t span;
+        if (!path.value(reinterpret_cast<const octet_t *>(image.data()), image.size(), span))
+            return "<none>";
+        return std::string(reinterpret_cast<const char *>(span.data), span.length);
+    }
+};
+
+const char *PathTests::sample =
+  "(private-key (rsa (n #61c12f77#) (e #010203#) (d #5a3f#) (p #03#) (q #05#)"
+  " (u #07#) (x (n nested)) (y) (z) (n second)) (protected-at \"20240101T000000\")"
+  " (comment ([h]protected-at inner)))";
+
+TEST_F(PathTests, Paths)
+{
+    struct {
+        const char *path;
+        const char *match; /* nullptr for the whole image */
+        const char *value;
+    } cases[] = {
+      {"private-key/rsa/n", "(1:n4:a\xc1/w)", "a\xc1/w"},
+      {"/private-key/rsa/e", "(1:e3:\x01\x02\x03)", "\x01\x02\x03"},
+      {"private-key/protected-at", "(12:protected-at15:20240101T000000)", "20240101T000000"},
+      {"//protected-at", "(12:protected-at15:20240101T000000)", "20240101T000000"},
+      {"private-key//n", "(1:n4:a\xc1/w)", "a\xc1/w"},
+      {"private-key/rsa/*/n", "(1:n6:nested)", "nested"},
+      {"//x//n", "(1:n6:nested)", "nested"},
+      {"private-key/comment/protected-at", "([1:h]12:protected-at5:inner)", "inner"},
+      {"private-key/rsa/y", "(1:y)", "<none>"},
+      {"*", nullptr, "<none>"},
+      {"public-key/rsa/n", "", "<none>"},
+      {"private-key/n", "", "<none>"},
+      {"private-key/rsa/n/x", "", "<none>"},
+    };
+    for (const auto &c : cases) {
+        sexp_path_t path(c.path);
+        std::string expected = c.match ? c.match : image;
+        EXPECT_EQ(tree_match(path), expected) << c.path;
+        EXPECT_EQ(image_match(path), expected) << c.path;
+        EXPECT_EQ(image_value(path), c.value) << c.path;
+        const auto *value = path.value(*tree);
+        if (strcmp(c.value, "<none>") == 0)
+            EXPECT_EQ(value, nullptr) << c.path;
+        else
+            EXPECT_EQ(*value, c.value) << c.path;
+    }
+}
+
+TEST_F(PathTests, FindAll)
+{
+    auto all = sexp_path_t("//n").find_all(*tree);
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(*all[0]->sexp_simple_string_at(1), "a\xc1/w");
+    EXPECT_EQ(*all[1]->sexp_simple_string_at(1), "nested");
+    EXPECT_EQ(*all[2]->sexp_simple_string_at(1), "second");
+    EXPECT_EQ(sexp_path_t("private-key/rsa/*").find_all(*tree).size(), 10);
+    EXPECT_TRUE(sexp_path_t("private-key/none").find_all(*tree).empty());
+
+    /* a failing first candidate does not hide later ones */
+    EXPECT_EQ(*sexp_path_t("private-key/rsa/x/n").value(*tree), "nested");
+}
+
+TEST_F(PathTests, BadPaths)
+{
+    EXPECT_THROW(sexp_path_t(""), sexp_exception_t);
+    EXPECT_THROW(sexp_path_t("a//"), sexp_exception_t);
+    EXPECT_THROW(sexp_path_t("a///b"), sexp_exception_t);
+    EXPECT_THROW(sexp_path_t(std::string(128, 'a').replace(1, 126, 63, '/')),
+                 sexp_exception_t);
+    EXPECT_EQ(sexp_path_t("a/b//c").size(), 3);
+}
+
+TEST_F(PathTests, BadImages)
+{
+    sexp_path_t         path("//n");
+    sexp_path_t::span_t span;
+    const char *        bad[] = {"(1:a", "(1:a(", "(5:ab)", "(1:a)x", "(1:a))", "(a)", "([1:h)"};
+    for (const char *b : bad) {
+        std::string img(b);
+        if (img == "(1:a)x" || img == "(1:a))") {
+            /* trailing bytes after the root are not examined */
+            EXPECT_FALSE(path.find(reinterpret_cast<const octet_t *>(img.data()), img.size(), span));
+            continue;
+        }
+        EXPECT_THROW(path.find(reinterpret_cast<const octet_t *>(img.data()), img.size(), span),
+                     sexp_exception_t)
+          << b;
+    }
+}
+
+} // namespace
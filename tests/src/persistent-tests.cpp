@@ -0,0 +1,151 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <thread>
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-persistent.h"
+
+using namespace sexp;
+
+namespace {
+
+const char *key_sample = "(private-key (rsa (n #00c12f77#) (e #010001#) (d #5a3f#)) "
+                         "(protected-at \"20260101T000000\") (comment test))";
+
+std::shared_ptr<sexp_object_t> parse(const std::string &input)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return is.set_byte_size(8)->get_char()->scan_object();
+}
+
+std::string advanced(const sexp_persistent_t::node_t &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    os.set_max_column(0);
+    obj->print_advanced(&os);
+    return oss.str();
+}
+
+TEST(PersistentTests, PathCopying)
+{
+    sexp_persistent_t        tree(parse(key_sample));
+    sexp_persistent_t::path_t d;
+    ASSERT_TRUE(tree.locate({"private-key", "rsa", "d"}, d));
+    EXPECT_EQ(d, sexp_persistent_t::path_t({1, 3}));
+
+    auto updated = tree.set({1, 3, 1}, parse("#0bad#"));
+    EXPECT_EQ(advanced(tree.root()), advanced(parse(key_sample)));
+    EXPECT_EQ(advanced(updated.at({1, 3})), "(d #0BAD#)");
+
+    /* the lists on the path are copied, everything else is shared */
+    EXPECT_NE(tree.root(), updated.root());
+    EXPECT_NE(tree.at({1}), updated.at({1}));
+    EXPECT_NE(tree.at({1, 3}), updated.at({1, 3}));
+    EXPECT_EQ(tree.at({0}), updated.at({0}));
+    EXPECT_EQ(tree.at({1, 1}), updated.at({1, 1}));
+    EXPECT_EQ(tree.at({1, 2}), updated.at({1, 2}));
+    EXPECT_EQ(tree.at({2}), updated.at({2}));
+    EXPECT_EQ(tree.at({3}), updated.at({3}));
+}
+
+TEST(PersistentTests, InsertAndErase)
+{
+    sexp_persistent_t tree(parse("(a (b c) d)"));
+
+    EXPECT_EQ(advanced(tree.insert({1, 2}, parse("x")).root()), "(a (b c x) d)");
+    EXPECT_EQ(advanced(tree.insert({1, 0}, parse("x")).root()), "(a (x b c) d)");
+    EXPECT_EQ(advanced(tree.insert({3}, parse("(y)")).root()), "(a (b c) d (y))");
+    EXPECT_EQ(advanced(tree.erase({1, 1}).root()), "(a (b) d)");
+    EXPECT_EQ(advanced(tree.erase({1}).root()), "(a d)");
+    EXPECT_EQ(advanced(tree.set({}, parse("z")).root()), "z");
+    EXPECT_EQ(advanced(tree.root()), "(a (b c) d)");
+
+    EXPECT_EQ(tree.at({1, 5}), nullptr);
+    EXPECT_EQ(tree.at({0, 0}), nullptr);
+    EXPECT_THROW(tree.set({1, 2}, parse("x")), sexp_exception_t);
+    EXPECT_THROW(tree.insert({1, 3}, parse("x")), sexp_exception_t);
+    EXPECT_THROW(tree.erase({0, 0}), sexp_exception_t);
+    EXPECT_THROW(tree.erase({}), sexp_exception_t);
+    EXPECT_THROW(tree.set({0}, nullptr), sexp_exception_t);
+}
+
+/* a list printed by its own override */
+class redacted_list_t : public sexp_list_t {
+  public:
+    sexp_output_stream_t *print_advanced(sexp_output_stream_t *os) const override
+    {
+        return os->put_char('*');
+    }
+};
+
+TEST(PersistentTests, DerivedLists)
+{
+    auto root = parse("(a (b c) d)");
+    auto redacted = std::make_shared<redacted_list_t>();
+    redacted->push_back(parse("secret"));
+    root->sexp_list_view()->push_back(redacted);
+    sexp_persistent_t tree(root);
+    EXPECT_EQ(advanced(tree.root()), "(a (b c) d *)");
+
+    /* derived lists off the path are shared with their overrides */
+    auto updated = tree.set({1, 0}, parse("x"));
+    EXPECT_EQ(advanced(updated.root()), "(a (x c) d *)");
+    EXPECT_EQ(updated.at({3}), tree.at({3}));
+
+    /* derived lists on the path cannot be copied */
+    EXPECT_THROW(tree.set({3, 0}, parse("x")), sexp_exception_t);
+    EXPECT_THROW(tree.erase({3, 0}), sexp_exception_t);
+}
+
+TEST(PersistentTests, ConcurrentReaders)
+{
+    sexp_persistent_t        base(parse(key_sample));
+    sexp_persistent_t::path_t n;
+    ASSERT_TRUE(base.locate({"private-key", "rsa", "n"}, n));
+    n.push_back(1);
+    const std::string image = advanced(base.root());
+
+    std::vector<std::thread> threads;
+    std::vector<bool>        ok(4, false);
+    for (size_t i = 0; i < ok.size(); i++)
+        threads.emplace_back([&base, &image, &ok, n, i]() {
+            bool good = true;
+            for (int j = 0; j < 100; j++) {
+                /* every thread derives its own versions from the shared tree */
+                auto mine = base.set(n, std::make_shared<sexp_string_t>(std::to_string(i)));
+                good = good && advanced(base.root()) == image &&
+                       *mine.at(n) == std::to_string(i).c_str() &&
+                       mine.at({2}) == base.at({2}) && sexp_hash(*base.root()) != 0;
+            }
+            ok[i] = good;
+        });
+    for (auto &t : threads)
+        t.join();
+    for (size_t i = 0; i < ok.size(); i++)
+        EXPECT_TRUE(ok[i]);
+}
+
+} // namespace
@@ -0,0 +1,157 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-intern.h"
+
+#ifdef SEXP_WITH_PMR
+
+using namespace sexp;
+
+namespace {
+
+const char *key_sample = "(private-key (rsa (n #00c12f779ade01c12f779ade01#) (e #010001#) "
+                         "(d |WjL/d5reAcEvd5reAcEvd5reAcEvd5reAcEv|)) "
+                         "(comment [text/plain]\"a comment that does not fit in place\"))";
+
+/* Counts memory requested from upstream */
+class counting_resource_t : public std::pmr::memory_resource {
+  public:
+    size_t allocated = 0;
+
+  protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/* Makes any allocation from the default resource fail */
+class no_default_resource_t {
+    std::pmr::memory_resource *saved;
+
+  public:
+    no_default_resource_t() : saved(std::pmr::set_default_resource(std::pmr::null_memory_resource()))
+    {
+    }
+    ~no_default_resource_t() { std::pmr::set_default_resource(saved); }
+};
+
+std::string canonical(const std::shared_ptr<sexp_object_t> &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj->print_canonical(&os);
+    return oss.str();
+}
+
+std::shared_ptr<sexp_object_t> parse(std::istream &               is,
+                                     std::pmr::memory_resource *  mr,
+                                     sexp_intern_table_t *table = nullptr)
+{
+    sexp_input_stream_t sis(&is);
+    return sis.set_memory_resource(mr)
+      ->set_intern_table(table)
+      ->set_byte_size(8)
+      ->get_char()
+      ->scan_object();
+}
+
+TEST(PmrTests, ObjectsUseStreamResource)
+{
+    std::istringstream reference_is(key_sample, std::ios_base::binary);
+    std::string        reference = canonical(parse(reference_is, std::pmr::get_default_resource()));
+
+    counting_resource_t upstream;
+    {
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        std::istringstream                  iss(key_sample, std::ios_base::binary);
+        no_default_resource_t               guard;
+        auto                                obj = parse(iss, &arena);
+        EXPECT_EQ(canonical(obj), reference);
+
+        auto list = obj->sexp_list_view();
+        EXPECT_EQ(list->get_allocator().resource(), &arena);
+        EXPECT_EQ(list->sexp_list_at(2)->sexp_string_at(1)->get_string().get_allocator().resource(),
+                  &arena);
+    }
+    EXPECT_GT(upstream.allocated, 0);
+}
+
+TEST(PmrTests, CopiedHintLeavesResource)
+{
+    const std::string   hint_text("text/plain; charset=utf-8; too long to be stored in place");
+    counting_resource_t copies;
+    std::pmr::memory_resource *saved = std::pmr::set_default_resource(&copies);
+    {
+        std::unique_ptr<sexp_string_t> copy;
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            sexp_allocator_t                    a(&arena);
+            sexp_string_t                       str(a);
+            str.set_presentation_hint(sexp_simple_string_t(
+              reinterpret_cast<const octet_t *>(hint_text.data()), hint_text.size()));
+            ASSERT_EQ(str.get_presentation_hint().get_allocator().resource(), &arena);
+
+            copy.reset(new sexp_string_t(str));
+            sexp_string_t assigned(a);
+            assigned = *copy;
+            EXPECT_EQ(assigned.get_presentation_hint().get_allocator().resource(), &copies);
+        }
+        /* the arena is gone, the copy shall neither read nor free memory of it */
+        EXPECT_EQ(copy->get_presentation_hint().get_allocator().resource(), &copies);
+        EXPECT_TRUE(copy->get_presentation_hint() == hint_text.c_str());
+    }
+    std::pmr::set_default_resource(saved);
+    EXPECT_GT(copies.allocated, hint_text.size());
+}
+
+TEST(PmrTests, InternedNodesOutliveResource)
+{
+    sexp_intern_table_t table;
+    std::string         first;
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        std::istringstream                  iss(key_sample, std::ios_base::binary);
+        first = canonical(parse(iss, &arena, &table));
+        EXPECT_NE(table.intern("private-key")->get_string().get_allocator().resource(), &arena);
+    }
+    std::pmr::monotonic_buffer_resource arena;
+    std::istringstream                  iss(key_sample, std::ios_base::binary);
+    auto                                obj = parse(iss, &arena, &table);
+    EXPECT_EQ(canonical(obj), first);
+    EXPECT_EQ(obj->sexp_list_view()->at(0), table.intern("private-key"));
+}
+
+} // namespace
+
+#endif
@@ -280,6 +280,65 @@ TEST_F(PrimitivesTests, u4rnp)
     EXPECT_EQ(lst.sexp_string_at(1)->as_unsigned(), 54321);
 }
 
+TEST_F(PrimitivesTests, magnitude)
+{
+    const octet_t        bytes[] = {0x00, 0x00, 0x01, 0x00, 0x01};
+    sexp_simple_string_t ss(bytes, sizeof(bytes));
+    auto                 mag = ss.magnitude();
+    EXPECT_EQ(mag.data, ss.data() + 2);
+    EXPECT_EQ(mag.length, 3);
+
+    const octet_t zeros[] = {0x00, 0x00};
+    EXPECT_EQ(sexp_simple_string_t(zeros, sizeof(zeros)).magnitude().length, 0);
+    EXPECT_EQ(sexp_simple_string_t().magnitude().length, 0);
+}
+
+TEST_F(PrimitivesTests, limbs)
+{
+    const octet_t bytes[] = {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c};
+    sexp_simple_string_t ss(bytes, sizeof(bytes));
+    EXPECT_EQ(ss.limb_count(), 2);
+
+    uint64_t limbs[3] = {1, 2, 3};
+    EXPECT_EQ(ss.to_limbs(limbs, 3), 2);
+    EXPECT_EQ(limbs[0], 0x05060708090a0b0cULL);
+    EXPECT_EQ(limbs[1], 0x01020304ULL);
+    EXPECT_EQ(limbs[2], 0);
+
+    uint64_t one[1] = {7};
+    EXPECT_EQ(ss.to_limbs(one, 1), 2);
+    EXPECT_EQ(one[0], 7);
+
+    const octet_t exact[] = {0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88};
+    EXPECT_EQ(sexp_simple_string_t(exact, sizeof(exact)).to_limbs(one, 1), 1);
+    EXPECT_EQ(one[0], 0xffeeddccbbaa9988ULL);
+    EXPECT_EQ(sexp_simple_string_t().to_limbs(one, 1), 0);
+    EXPECT_EQ(one[0], 0);
+}
+
+TEST_F(PrimitivesTests, decimal)
+{
+    auto     parse = [](const char *str, uint64_t &value) {
+        return sexp_simple_string_t(reinterpret_cast<const octet_t *>(str)).to_uint64(value);
+    };
+    uint64_t value = 0;
+    EXPECT_TRUE(parse("0", value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(parse("65537", value));
+    EXPECT_EQ(value, 65537);
+    EXPECT_TRUE(parse("18446744073709551615", value));
+    EXPECT_EQ(value, std::numeric_limits<uint64_t>::max());
+
+    const char *bad[] = {"", "18446744073709551616", "99999999999999999999", "-1", "+1",
+                         " 1", "1 ", "12abc", "0x10"};
+    for (const char *str : bad) {
+        value = 42;
+        EXPECT_FALSE(parse(str, value)) << str;
+        EXPECT_EQ(value, 42) << str;
+    }
+}
+
 TEST_F(PrimitivesTests, proInheritance)
 {
     sexp_list_t lst;
@@ -379,6 +438,142 @@ TEST_F(PrimitivesTests, ListWrapTest)
     EXPECT_EQ(oss.str(), "(abc\n )");
 }
 
+TEST_F(PrimitivesTests, NestedWrapTest)
+{
+    const char *str_in = "(key (rsa (n abcdefgh) (e ijk) (d lmnopqrstu)) (flags \"12345\" \"a b\"))";
+    const struct {
+        uint32_t    max_column;
+        const char *str_out;
+    } samples[] = {
+      {0, "(key (rsa (n abcdefgh) (e ijk) (d lmnopqrstu)) (flags \"12345\" \"a b\"))"},
+      {10,
+       "(key\n (rsa\n  (n\n   \"abcd\\\nefgh\")\n  (e ijk)\n  (d\n   \"lmno\\\npqrstu\"))\n"
+       " (flags\n  \"12345\"\n  \"a b\"))"},
+      {14,
+       "(key\n (rsa\n  (n abcdefgh\n   )\n  (e ijk)\n  (d\n   lmnopqrstu\n   ))\n (flags\n  "
+       "\"12345\"\n  \"a b\"))"},
+      {20,
+       "(key\n (rsa\n  (n abcdefgh)\n  (e ijk)\n  (d lmnopqrstu))\n (flags\n  \"12345\"\n  "
+       "\"a b\"))"},
+    };
+
+    for (const auto &sample : samples) {
+        std::istringstream  iss(str_in);
+        sexp_input_stream_t is(&iss);
+        const auto          obj = is.set_byte_size(8)->get_char()->scan_object();
+
+        std::ostringstream   oss(std::ios_base::binary);
+        sexp_output_stream_t os(&oss);
+        os.set_max_column(sample.max_column)->print_advanced(obj);
+        EXPECT_EQ(oss.str(), sample.str_out);
+    }
+}
+
+TEST_F(PrimitivesTests, DeepListAdvanced)
+{
+    const size_t depth = 2000;
+    auto         root = std::make_shared<sexp_list_t>();
+    sexp_list_t *list = root.get();
+    for (size_t i = 0; i < depth; i++) {
+        auto sublist = std::make_shared<sexp_list_t>();
+        list->push_back(std::make_shared<sexp_string_t>(std::string("a")));
+        list->push_back(sublist);
+        list = sublist.get();
+    }
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss, 0);
+    os.set_max_column(0)->print_advanced(std::static_pointer_cast<sexp_object_t>(root));
+
+    std::string sample;
+    for (size_t i = 0; i < depth; i++)
+        sample += "(a ";
+    sample += "()";
+    sample += std::string(depth, ')');
+    EXPECT_EQ(oss.str(), sample);
+}
+
+TEST_F(PrimitivesTests, SimpleStringClassification)
+{
+    sexp_simple_string_t ss(reinterpret_cast<const octet_t *>("abc"));
+    EXPECT_TRUE(ss.can_print_as_token());
+    EXPECT_TRUE(ss.can_print_as_quoted_string());
+
+    ss.append(' ');
+    EXPECT_FALSE(ss.can_print_as_token());
+    EXPECT_TRUE(ss.can_print_as_quoted_string());
+
+    sexp_simple_string_t copy(ss);
+    ss.append('\t');
+    EXPECT_FALSE(ss.can_print_as_token());
+    EXPECT_FALSE(ss.can_print_as_quoted_string());
+    EXPECT_TRUE(copy.can_print_as_quoted_string());
+
+    ss.assign(reinterpret_cast<const octet_t *>("1abc"));
+    EXPECT_FALSE(ss.can_print_as_token());
+    EXPECT_TRUE(ss.can_print_as_quoted_string());
+
+    /* every modifier drops the cached classes and hash */
+    uint64_t h = ss.hash();
+    ss.set(0, 'x');
+    EXPECT_TRUE(ss.can_print_as_token());
+    EXPECT_NE(ss.hash(), h);
+    ss.resize(2);
+    EXPECT_TRUE(ss == "xa");
+    ss.append(reinterpret_cast<const octet_t *>("\n"), 1);
+    EXPECT_FALSE(ss.can_print_as_quoted_string());
+    ss.clear();
+    EXPECT_FALSE(ss.can_print_as_token());
+    EXPECT_EQ(ss.hash(), sexp_simple_string_t().hash());
+
+    /* a moved-from string is empty and has no stale classes */
+    sexp_simple_string_t token(reinterpret_cast<const octet_t *>("token"));
+    EXPECT_TRUE(token.can_print_as_token());
+    sexp_simple_string_t moved(std::move(token));
+    EXPECT_TRUE(moved.can_print_as_token());
+    EXPECT_TRUE(token.empty());
+    EXPECT_FALSE(token.can_print_as_token());
+    token = std::move(moved);
+    EXPECT_TRUE(token.can_print_as_token());
+    EXPECT_FALSE(moved.can_print_as_token());
+
+    moved.swap(token);
+    EXPECT_TRUE(moved.can_print_as_token());
+    EXPECT_FALSE(token.can_print_as_token());
+
+    sexp_simple_string_t empty;
+    EXPECT_FALSE(empty.can_print_as_token());
+    EXPECT_TRUE(empty.can_print_as_quoted_string());
+}
+
+TEST_F(PrimitivesTests, SimpleStringOctetStringInterface)
+{
+    sexp_simple_string_t a(reinterpret_cast<const octet_t *>("abc"));
+    sexp_simple_string_t b(a);
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a < b);
+    EXPECT_TRUE(a.substr(1) == octet_string(reinterpret_cast<const octet_t *>("bc")));
+
+    /* modifiers of the octet_string interface drop the cached classes too */
+    EXPECT_TRUE(a.can_print_as_token());
+    a += ' ';
+    EXPECT_FALSE(a.can_print_as_token());
+    a.erase(3);
+    EXPECT_TRUE(a.can_print_as_token());
+    a[0] = '\n';
+    EXPECT_FALSE(a.can_print_as_quoted_string());
+    a.replace(0, 1, 1, 'x');
+    EXPECT_TRUE(a.can_print_as_token());
+    a.insert(a.begin(), '1');
+    EXPECT_FALSE(a.can_print_as_token());
+    a.assign(b);
+    EXPECT_TRUE(a.can_print_as_token());
+    EXPECT_EQ(a.hash(), b.hash());
+    *a.begin() = '\t';
+    EXPECT_FALSE(a.can_print_as_quoted_string());
+    EXPECT_NE(a.hash(), b.hash());
+}
+
 TEST_F(PrimitivesTests, EnsureHexTest)
 {
     std::istringstream  iss("(3:a\011c)");
@@ -391,4 +586,46 @@ TEST_F(PrimitivesTests, EnsureHexTest)
     EXPECT_EQ(oss.str(), "(#610963#)");
 }
 
+TEST_F(PrimitivesTests, FindToken)
+{
+    std::istringstream  iss("(private-key (rsa (n #00c1#) (e #010001#) (d #5a3f#) \"p\" (q x)"
+                            " ([h]u y) (e second) () p (p z) (n) (extra) (more) (items)))");
+    sexp_input_stream_t is(&iss);
+    const auto          obj = is.set_byte_size(8)->get_char()->scan_object();
+    const auto *        key = obj->sexp_list_view();
+
+    /* short list: scanned */
+    const auto *rsa = key->find_token("rsa");
+    ASSERT_NE(rsa, nullptr);
+    EXPECT_EQ(rsa, key->sexp_list_at(1));
+    EXPECT_EQ(key->find_token("private-key"), nullptr);
+
+    /* long list: indexed, first match wins, atoms and hints are not considered */
+    ASSERT_GE(rsa->size(), sexp_list_t::TOKEN_INDEX_THRESHOLD);
+    EXPECT_EQ(rsa->find_token("n"), rsa->sexp_list_at(1));
+    EXPECT_EQ(rsa->find_token(std::string("e")), rsa->sexp_list_at(2));
+    EXPECT_EQ(rsa->find_token("p"), rsa->sexp_list_at(10));
+    EXPECT_EQ(rsa->find_token("u"), rsa->sexp_list_at(6));
+    EXPECT_EQ(rsa->find_token("h"), nullptr);
+    EXPECT_EQ(rsa->find_token("x"), nullptr);
+    EXPECT_EQ(rsa->find_token(""), nullptr);
+
+    /* the index follows modifications of the list, copies have their own index */
+    sexp_list_t copy(*rsa);
+    const auto *n = rsa->sexp_list_at(1);
+    auto *      mutable_rsa = const_cast<sexp_list_t *>(rsa);
+    auto  added = std::make_shared<sexp_list_t>();
+    added->push_back(std::make_shared<sexp_string_t>(std::string("x")));
+    mutable_rsa->push_back(added);
+    EXPECT_EQ(rsa->find_token("x"), added.get());
+    mutable_rsa->replace(1, added);
+    EXPECT_EQ(rsa->find_token("x"), added.get());
+    EXPECT_EQ(rsa->find_token("n"), rsa->sexp_list_at(11));
+    mutable_rsa->erase(mutable_rsa->begin() + 1, mutable_rsa->end());
+    EXPECT_EQ(rsa->find_token("n"), nullptr);
+
+    EXPECT_EQ(copy.find_token("x"), nullptr);
+    EXPECT_EQ(copy.find_token("n"), n);
+}
+
 } // namespace
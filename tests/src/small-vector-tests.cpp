@@ -0,0 +1,217 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+
+using namespace sexp;
+
+namespace {
+
+typedef sexp_small_vector_t<std::shared_ptr<int>, 3> small_vector;
+
+std::vector<int> values(const small_vector &v)
+{
+    std::vector<int> res;
+    for (const auto &p : v)
+        res.push_back(*p);
+    return res;
+}
+
+TEST(SmallVectorTests, InlineAndSpill)
+{
+    small_vector v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 3);
+    const void *inline_data = v.data();
+
+    for (int i = 0; i < 3; i++)
+        v.push_back(std::make_shared<int>(i));
+    EXPECT_EQ(v.data(), inline_data);
+    EXPECT_EQ(v.capacity(), 3);
+
+    v.emplace_back(std::make_shared<int>(3));
+    EXPECT_NE(v.data(), inline_data);
+    EXPECT_GE(v.capacity(), 4);
+    EXPECT_EQ(values(v), std::vector<int>({0, 1, 2, 3}));
+
+    v.pop_back();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.data(), inline_data);
+    EXPECT_EQ(values(v), std::vector<int>({0, 1, 2}));
+    EXPECT_THROW(v.at(3), std::out_of_range);
+}
+
+TEST(SmallVectorTests, InsertErase)
+{
+    small_vector v;
+    v.push_back(std::make_shared<int>(1));
+    v.push_back(std::make_shared<int>(4));
+    v.insert(v.begin(), std::make_shared<int>(0));
+    v.insert(v.begin() + 2, {std::make_shared<int>(2), std::make_shared<int>(3)});
+    EXPECT_EQ(values(v), std::vector<int>({0, 1, 2, 3, 4}));
+
+    auto it = v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_EQ(**it, 3);
+    EXPECT_EQ(values(v), std::vector<int>({0, 3, 4}));
+    v.erase(v.begin());
+    EXPECT_EQ(values(v), std::vector<int>({3, 4}));
+
+    /* element of the container itself, relocated while pushing */
+    v.push_back(v[0]);
+    v.push_back(v[1]);
+    EXPECT_EQ(values(v), std::vector<int>({3, 4, 3, 4}));
+    EXPECT_EQ(v[0].use_count(), 2);
+
+    /* range of the container itself, the storage grows while inserting */
+    v.shrink_to_fit();
+    v.insert(v.begin() + 1, v.begin(), v.end());
+    EXPECT_EQ(values(v), std::vector<int>({3, 3, 4, 3, 4, 4, 3, 4}));
+    v.insert(v.end(), v.begin(), v.begin() + 2);
+    EXPECT_EQ(values(v), std::vector<int>({3, 3, 4, 3, 4, 4, 3, 4, 3, 3}));
+}
+
+TEST(SmallVectorTests, CopyMoveSwap)
+{
+    auto         shared = std::make_shared<int>(7);
+    small_vector small{shared, shared};
+    small_vector large(5, shared);
+    EXPECT_EQ(shared.use_count(), 8);
+
+    small_vector copy(large);
+    EXPECT_EQ(copy, large);
+    EXPECT_EQ(shared.use_count(), 13);
+
+    small_vector moved(std::move(small));
+    EXPECT_TRUE(small.empty());
+    EXPECT_EQ(moved.size(), 2);
+    const void *heap = large.data();
+    moved = std::move(large);
+    EXPECT_TRUE(large.empty());
+    EXPECT_EQ(moved.data(), heap);
+    EXPECT_EQ(shared.use_count(), 11);
+
+    swap(moved, copy);
+    EXPECT_EQ(copy.data(), heap);
+    copy.resize(1);
+    moved.clear();
+    EXPECT_EQ(shared.use_count(), 2);
+}
+
+TEST(SmallVectorTests, Version)
+{
+    small_vector v;
+    v.push_back(std::make_shared<int>(1));
+    v.push_back(std::make_shared<int>(2));
+    uint32_t ver = v.version();
+
+    /* element access does not count, so readers of a shared vector do not write to it */
+    EXPECT_EQ(*v[0] + *v.front() + *v.back() + *v.at(1), 6);
+    EXPECT_EQ(v.begin() + 2, v.end());
+    EXPECT_NE(v.data(), nullptr);
+    EXPECT_EQ(v.version(), ver);
+
+    v.replace(1, std::make_shared<int>(3));
+    EXPECT_EQ(*v[1], 3);
+    EXPECT_NE(v.version(), ver);
+    ver = v.version();
+    v.erase(v.begin());
+    EXPECT_NE(v.version(), ver);
+    ver = v.version();
+    v.insert(v.begin(), std::make_shared<int>(4));
+    EXPECT_NE(v.version(), ver);
+    ver = v.version();
+    v.clear();
+    EXPECT_NE(v.version(), ver);
+}
+
+TEST(SmallVectorTests, Segments)
+{
+    small_vector v;
+    v.set_segment_size(5);
+    EXPECT_EQ(v.segment_size(), 8);
+    for (int i = 0; i < 8; i++)
+        v.push_back(std::make_shared<int>(i));
+    EXPECT_FALSE(v.is_segmented());
+    EXPECT_EQ(v.capacity(), 8);
+    const std::shared_ptr<int> *block = v.data();
+
+    /* the full block becomes the first segment, its elements do not move */
+    v.push_back(std::make_shared<int>(8));
+    EXPECT_TRUE(v.is_segmented());
+    EXPECT_EQ(v.data(), nullptr);
+    EXPECT_EQ(&v[0], block);
+    EXPECT_EQ(v.capacity(), 16);
+
+    std::vector<const std::shared_ptr<int> *> addresses;
+    for (int i = 9; i < 100; i++)
+        v.push_back(std::make_shared<int>(i));
+    for (const auto &p : v)
+        addresses.push_back(&p);
+    for (int i = 100; i < 1000; i++)
+        v.push_back(std::make_shared<int>(i));
+    for (size_t i = 0; i < addresses.size(); i++)
+        EXPECT_EQ(&v[i], addresses[i]);
+    EXPECT_EQ(v.capacity(), 1000);
+    std::vector<int> expected(1000);
+    for (int i = 0; i < 1000; i++)
+        expected[i] = i;
+    EXPECT_EQ(values(v), expected);
+
+    /* modifiers work across segments */
+    v.erase(v.begin() + 5, v.begin() + 995);
+    EXPECT_EQ(values(v), std::vector<int>({0, 1, 2, 3, 4, 995, 996, 997, 998, 999}));
+    v.insert(v.begin() + 1, v.begin() + 5, v.end());
+    EXPECT_EQ(values(v),
+              std::vector<int>({0, 995, 996, 997, 998, 999, 1, 2, 3, 4, 995, 996, 997, 998, 999}));
+    EXPECT_EQ(*v.rbegin()[1], 998);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 16);
+
+    small_vector copy(v);
+    EXPECT_EQ(copy, v);
+    EXPECT_TRUE(copy.is_segmented());
+    small_vector moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(copy.is_segmented());
+    EXPECT_EQ(moved, v);
+    moved.clear();
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.capacity(), 8);
+    EXPECT_TRUE(moved.is_segmented());
+}
+
+TEST(SmallVectorTests, ListChildren)
+{
+    std::istringstream  iss("(a (b c) (d e f g h) ())", std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    auto                obj = is.set_byte_size(8)->get_char()->scan_object();
+    auto               *list = obj->sexp_list_view();
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(list->size(), 4);
+    EXPECT_EQ(list->sexp_list_at(1)->size(), 2);
+    EXPECT_EQ(list->sexp_list_at(2)->size(), 5);
+    EXPECT_TRUE(list->sexp_list_at(3)->empty());
+    EXPECT_EQ(*list->sexp_list_at(2)->sexp_simple_string_at(4), "h");
+}
+
+} // namespace
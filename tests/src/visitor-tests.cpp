@@ -0,0 +1,187 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-visitor.h"
+
+using namespace sexp;
+
+namespace {
+
+std::shared_ptr<sexp_object_t> parse(const std::string &input)
+{
+    std::istringstream  iss(input, std::ios_base::binary);
+    sexp_input_stream_t is(&iss);
+    return is.set_byte_size(8)->get_char()->scan_object();
+}
+
+/* Records the walk as a string: strings by contents, lists as "(" and ")" */
+class recorder_t : public sexp_visitor_t<recorder_t> {
+  public:
+    std::string trace;
+    std::string skip_token;
+    std::string stop_token;
+
+    action_t visit_string(const sexp_string_t &str)
+    {
+        std::string s(reinterpret_cast<const char *>(str.get_string().data()),
+                      str.get_string().length());
+        trace += s + " ";
+        return s == stop_token ? stop : proceed;
+    }
+    action_t enter_list(const sexp_list_t &list)
+    {
+        trace += "( ";
+        const sexp_simple_string_t *first = list.sexp_simple_string_at(0);
+        return first != nullptr && *first == skip_token.c_str() ? skip : proceed;
+    }
+    action_t leave_list(const sexp_list_t &)
+    {
+        trace += ") ";
+        return proceed;
+    }
+};
+
+TEST(VisitorTests, PreAndPostOrder)
+{
+    auto       obj = parse("(a (b c) [h]d () (e (f)))");
+    recorder_t rec;
+    EXPECT_TRUE(rec.traverse(*obj));
+    EXPECT_EQ(rec.trace, "( a ( b c ) d ( ) ( e ( f ) ) ) ");
+
+    recorder_t atom;
+    EXPECT_TRUE(atom.traverse(*parse("x")));
+    EXPECT_EQ(atom.trace, "x ");
+}
+
+TEST(VisitorTests, SkipAndStop)
+{
+    auto obj = parse("(a (b c) (e (f)) g)");
+
+    recorder_t skipping;
+    skipping.skip_token = "b";
+    EXPECT_TRUE(skipping.traverse(*obj));
+    EXPECT_EQ(skipping.trace, "( a ( ) ( e ( f ) ) g ) ");
+
+    recorder_t stopping;
+    stopping.stop_token = "e";
+    EXPECT_FALSE(stopping.traverse(*obj));
+    EXPECT_EQ(stopping.trace, "( a ( b c ) ( e ");
+}
+
+TEST(VisitorTests, KindTags)
+{
+    auto obj = parse("(a b)");
+    EXPECT_EQ(obj->get_kind(), sexp_object_t::list_kind);
+    EXPECT_EQ(obj->sexp_list_view()->at(0)->get_kind(), sexp_object_t::string_kind);
+    EXPECT_EQ(sexp_string_t("x").get_kind(), sexp_object_t::string_kind);
+    EXPECT_EQ(sexp_list_t().get_kind(), sexp_object_t::list_kind);
+
+    sexp_list_t copy(*obj->sexp_list_view());
+    EXPECT_EQ(copy.get_kind(), sexp_object_t::list_kind);
+}
+
+TEST(VisitorTests, AdvancedPrintOfManyLists)
+{
+    /* sibling lists do not add up to the depth limit of the output stream */
+    std::string text = "(";
+    for (int i = 0; i < 2000; i++)
+        text += "(a b)";
+    text += ")";
+    auto                 obj = parse(text);
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    os.set_max_column(0)->print_advanced(obj);
+    EXPECT_EQ(oss.str().size(), 2 + 2000 * 5 + 1999);
+}
+
+/* Prints as a fixed atom whatever it holds */
+class redacted_string_t : public sexp_string_t {
+  public:
+    redacted_string_t(const std::string &s) : sexp_string_t(s) {}
+    sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const override
+    {
+        return os->var_put_chars(reinterpret_cast<const octet_t *>("1:*"), 3);
+    }
+    sexp_output_stream_t *print_advanced(sexp_output_stream_t *os) const override
+    {
+        return os->put_char('*');
+    }
+    size_t advanced_length(sexp_output_stream_t *) const override { return 1; }
+};
+
+/* Prints its elements in reverse order */
+class reversed_list_t : public sexp_list_t {
+  public:
+    sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const override
+    {
+        sexp_list_t copy(*this);
+        std::reverse(copy.begin(), copy.end());
+        return copy.print_canonical(os);
+    }
+};
+
+/* Adds a marker around the image of the base class */
+class marked_list_t : public sexp_list_t {
+  public:
+    sexp_output_stream_t *print_canonical(sexp_output_stream_t *os) const override
+    {
+        os->var_put_chars(reinterpret_cast<const octet_t *>("1:<"), 3);
+        sexp_list_t::print_canonical(os);
+        return os->var_put_chars(reinterpret_cast<const octet_t *>("1:>"), 3);
+    }
+};
+
+std::string canonical(const sexp_object_t &obj)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    obj.print_canonical(&os);
+    return oss.str();
+}
+
+TEST(VisitorTests, DerivedClassesKeepOverrides)
+{
+    auto reversed = std::make_shared<reversed_list_t>();
+    reversed->push_back(std::make_shared<sexp_string_t>("x"));
+    reversed->push_back(std::make_shared<redacted_string_t>("secret"));
+    auto marked = std::make_shared<marked_list_t>();
+    marked->push_back(std::make_shared<sexp_string_t>("m"));
+
+    sexp_list_t tree;
+    tree.push_back(std::make_shared<redacted_string_t>("secret"));
+    tree.push_back(reversed);
+    tree.push_back(marked);
+
+    EXPECT_EQ(canonical(tree), "(1:*(1:*1:x)1:<(1:m)1:>)");
+    EXPECT_EQ(canonical(*marked), "1:<(1:m)1:>");
+
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    tree.print_advanced(&os);
+    EXPECT_EQ(oss.str(), "(* (x *) (m))");
+    /* advanced_length does not count the blanks between elements */
+    EXPECT_EQ(tree.advanced_length(&os), oss.str().size() - 3);
+}
+
+} // namespace
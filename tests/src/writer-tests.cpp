@@ -0,0 +1,150 @@
+/**
+ *
+ * Copyright 2026 Ribose Inc. (https://www.ribose.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "sexp-tests.h"
+#include "sexpp/sexp-writer.h"
+
+using namespace sexp;
+
+namespace {
+
+class WriterTests : public testing::Test {
+  protected:
+    /* (public-key (rsa (n |...|) (e #010001#)) [text]"hello world" "") */
+    static void write_sample(sexp_writer_t &writer)
+    {
+        const octet_t n[] = {0x00, 0xc1, 0x2f, 0x77, 0x10, 0x9a, 0xde, 0x01};
+        const octet_t e[] = {0x01, 0x00, 0x01};
+        writer.begin_list()
+          ->atom("public-key")
+          ->begin_list()
+          ->atom("rsa")
+          ->begin_list()
+          ->atom("n")
+          ->atom(n, sizeof(n))
+          ->end_list()
+          ->begin_list()
+          ->atom("e")
+          ->atom(e, sizeof(e))
+          ->end_list()
+          ->end_list()
+          ->atom_with_hint("text", "hello world")
+          ->atom("")
+          ->begin_list()
+          ->end_list()
+          ->end_list();
+    }
+
+    static std::shared_ptr<sexp_object_t> build_sample(void)
+    {
+        std::ostringstream   oss(std::ios_base::binary);
+        sexp_output_stream_t os(&oss);
+        sexp_writer_t        writer(&os);
+        write_sample(writer);
+
+        std::istringstream  iss(oss.str(), std::ios_base::binary);
+        sexp_input_stream_t is(&iss);
+        return is.set_byte_size(8)->get_char()->scan_object();
+    }
+};
+
+TEST_F(WriterTests, Canonical)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    sexp_writer_t        writer(&os);
+    write_sample(writer);
+    EXPECT_EQ(writer.get_depth(), 0);
+    const char sample[] = "(10:public-key(3:rsa(1:n8:\x00\xc1\x2f\x77\x10\x9a\xde\x01)"
+                          "(1:e3:\x01\x00\x01))[4:text]11:hello world0:())";
+    EXPECT_EQ(oss.str(), std::string(sample, sizeof(sample) - 1));
+}
+
+TEST_F(WriterTests, SameAsTree)
+{
+    auto obj = build_sample();
+
+    std::ostringstream   oss1(std::ios_base::binary);
+    sexp_output_stream_t os1(&oss1);
+    os1.set_max_column(0)->print_base64(obj);
+    std::ostringstream   oss2(std::ios_base::binary);
+    sexp_output_stream_t os2(&oss2);
+    sexp_writer_t        writer2(os2.set_max_column(0), sexp_output_stream_t::base64);
+    write_sample(writer2);
+    EXPECT_EQ(oss2.str(), oss1.str());
+
+    std::ostringstream   oss3(std::ios_base::binary);
+    sexp_output_stream_t os3(&oss3);
+    os3.set_max_column(0)->print_advanced(obj);
+    std::ostringstream   oss4(std::ios_base::binary);
+    sexp_output_stream_t os4(&oss4);
+    sexp_writer_t        writer4(&os4, sexp_output_stream_t::advanced);
+    write_sample(writer4);
+    EXPECT_EQ(oss4.str(), oss3.str());
+    EXPECT_EQ(oss4.str(),
+              "(public-key (rsa (n |AMEvdxCa3gE=|) (e #010001#)) [text]\"hello world\" \"\" ())");
+}
+
+TEST_F(WriterTests, RestoresMaxColumn)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    os.set_max_column(20);
+    {
+        sexp_writer_t writer(&os, sexp_output_stream_t::advanced);
+        EXPECT_EQ(os.get_max_column(), 0u);
+        write_sample(writer);
+    }
+    EXPECT_EQ(os.get_max_column(), 20u);
+}
+
+TEST_F(WriterTests, TopLevelAtoms)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss);
+    sexp_writer_t        writer(&os, sexp_output_stream_t::base64);
+    writer.atom("abc")->atom("d");
+    EXPECT_EQ(oss.str(), "{MzphYmM=}{MTpk}");
+}
+
+TEST_F(WriterTests, Depth)
+{
+    std::ostringstream   oss(std::ios_base::binary);
+    sexp_output_stream_t os(&oss, 2);
+    sexp_writer_t        writer(&os);
+    writer.begin_list()->begin_list();
+    EXPECT_EQ(writer.get_depth(), 2);
+    EXPECT_THROW(writer.begin_list(), sexp_exception_t);
+
+    std::ostringstream   oss2(std::ios_base::binary);
+    sexp_output_stream_t os2(&oss2);
+    sexp_writer_t        writer2(&os2);
+    try {
+        writer2.begin_list()->end_list()->end_list();
+        FAIL() << "sexp::sexp_exception_t expected but has not been thrown";
+    } catch (sexp::sexp_exception_t &e) {
+        EXPECT_STREQ(e.what(), "SEXP ERROR: There is no open list to close");
+    }
+}
+
+} // namespace